@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+##############################################################################
+##
+## (C) Copyright Ion Gaztanaga 2014-2014 Distributed under the Boost
+## Software License, Version 1.0. (See accompanying file
+## LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+##
+##
+##############################################################################
+"""Measures the compile-time cost of the unique_ptr headers.
+
+For each mode (C++03 and C++11) it reports the best of several runs of:
+
+ * parsing a translation unit that only includes each header
+   (-fsyntax-only), minus the time to parse an empty translation unit.
+ * compiling bench_compile_unique_ptr.cpp, which instantiates unique_ptr
+   for BOOST_MOVE_BENCH_COMPILE_TYPES types, at -O0.
+
+Usage:
+   bench_compile.py [--cxx g++] [-I dir]... [--runs 5] [--types 200]
+"""
+
+from __future__ import print_function
+
+import optparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+MODES = ['c++03', 'c++11']
+HEADERS = [
+   'boost/move/core.hpp',
+   'boost/move/utility.hpp',
+   'boost/move/default_delete.hpp',
+   'boost/move/unique_ptr.hpp',
+   'boost/move/make_unique.hpp',
+]
+
+def best_time(args, runs):
+   best = None
+   for i in range(runs):
+      start = time.time()
+      if subprocess.call(args) != 0:
+         raise SystemExit('command failed: ' + ' '.join(args))
+      elapsed = time.time() - start
+      best = elapsed if best is None else min(best, elapsed)
+   return best
+
+def main():
+   parser = optparse.OptionParser(usage=__doc__)
+   parser.add_option('--cxx', default=os.environ.get('CXX', 'g++'))
+   parser.add_option('-I', dest='include', action='append', default=[])
+   parser.add_option('--runs', type='int', default=5)
+   parser.add_option('--types', type='int', default=200)
+   opts, args = parser.parse_args()
+
+   here = os.path.dirname(os.path.abspath(__file__))
+   includes = ['-I' + d for d in opts.include + [os.path.join(here, '..', 'include')]]
+   tmpdir = tempfile.mkdtemp()
+   try:
+      for mode in MODES:
+         base = [opts.cxx, '-std=' + mode, '-w'] + includes
+         empty = os.path.join(tmpdir, 'empty.cpp')
+         open(empty, 'w').close()
+         empty_time = best_time(base + ['-fsyntax-only', empty], opts.runs)
+         for header in HEADERS:
+            src = os.path.join(tmpdir, 'header.cpp')
+            f = open(src, 'w')
+            f.write('#include <%s>\n' % header)
+            f.close()
+            t = best_time(base + ['-fsyntax-only', src], opts.runs)
+            print('%-6s %-46s %8.1f ms' % (mode, header, (t - empty_time)*1000.0))
+         obj = os.path.join(tmpdir, 'bench.o')
+         t = best_time(base + ['-O0', '-DBOOST_MOVE_BENCH_COMPILE_TYPES=%d' % opts.types, '-c',
+                               os.path.join(here, 'bench_compile_unique_ptr.cpp'), '-o', obj], opts.runs)
+         print('%-6s %-46s %8.1f ms' % (mode, 'instantiate %d unique_ptr types' % opts.types, t*1000.0))
+   finally:
+      for name in os.listdir(tmpdir):
+         os.remove(os.path.join(tmpdir, name))
+      os.rmdir(tmpdir)
+   return 0
+
+if __name__ == '__main__':
+   sys.exit(main())
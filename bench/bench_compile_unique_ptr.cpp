@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Compile-time benchmark: instantiates the constructors, converting moves and
+//resets of unique_ptr for BOOST_MOVE_BENCH_COMPILE_TYPES different types.
+//The interesting figure is the time needed to compile this file, measured by
+//bench_compile.py, the run time is irrelevant.
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/make_unique.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <cstdio>
+
+#ifndef BOOST_MOVE_BENCH_COMPILE_TYPES
+#define BOOST_MOVE_BENCH_COMPILE_TYPES 200
+#endif
+
+namespace bml = ::boost::movelib;
+
+template<int N>
+struct base_t
+{
+   base_t() : value(N) {}
+   virtual ~base_t() {}
+   int value;
+};
+
+template<int N>
+struct derived_t : base_t<N>
+{};
+
+template<int N>
+int instantiate()
+{
+   //Single object: pointer, converting move construction and assignment
+   bml::unique_ptr<derived_t<N> > d(new derived_t<N>);
+   bml::unique_ptr<base_t<N> > b(::boost::move(d));
+   d.reset(new derived_t<N>);
+   b = ::boost::move(d);
+   b.reset(new derived_t<N>);
+   d = bml::make_unique<derived_t<N> >();
+   b = ::boost::move(d);
+
+   //Arrays: pointer, qualification conversions and reset
+   bml::unique_ptr<base_t<N>[]> a(new base_t<N>[2]);
+   bml::unique_ptr<const base_t<N>[]> ca(::boost::move(a));
+   ca.reset(new base_t<N>[1]);
+   a = bml::make_unique<base_t<N>[]>(3u);
+   ca = ::boost::move(a);
+
+   return (b && !d && ca && !a) ? b->value + ca[2].value : -1;
+}
+
+#define BOOST_MOVE_BENCH_INSTANTIATE(z, n, data) + instantiate<n>()
+
+int main()
+{
+   const int sum = 0 BOOST_PP_REPEAT(BOOST_MOVE_BENCH_COMPILE_TYPES, BOOST_MOVE_BENCH_INSTANTIATE, ~);
+   std::printf("%d\n", sum);
+   return sum < 0;
+}
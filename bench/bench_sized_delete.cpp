@@ -0,0 +1,93 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Compares default_delete with and without BOOST_MOVE_USE_SIZED_DEALLOCATION
+//when destroying small objects. Compilers that already emit sized deallocation
+//calls for "delete p" (e.g. GCC in C++14 mode) should show parity.
+
+#define BOOST_MOVE_USE_SIZED_DEALLOCATION
+#include <boost/move/default_delete.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <new>
+
+namespace bml = ::boost::movelib;
+
+template<std::size_t N>
+struct small_object
+{
+   char data[N];
+};
+
+static const std::size_t NumObjects = 1024;
+static const std::size_t NumIterations = 4096;
+
+//Plain delete expression, the behaviour of default_delete without the opt-in
+struct plain_delete
+{
+   template<class T>
+   void operator()(T *p) const
+   {  delete p;  }
+};
+
+//Explicit destruction plus unsized deallocation
+struct unsized_delete
+{
+   template<class T>
+   void operator()(T *p) const
+   {  p->~T(); ::operator delete(static_cast<void*>(p));  }
+};
+
+template<class T, class Deleter>
+double run(Deleter d)
+{
+   static T *objects[NumObjects];
+   std::clock_t total = 0;
+   for(std::size_t it = 0; it != NumIterations; ++it){
+      for(std::size_t i = 0; i != NumObjects; ++i){
+         objects[i] = new T;
+      }
+      std::clock_t const start = std::clock();
+      for(std::size_t i = 0; i != NumObjects; ++i){
+         d(objects[i]);
+      }
+      total += std::clock() - start;
+   }
+   return double(total)*1e9/CLOCKS_PER_SEC/double(NumIterations*NumObjects);
+}
+
+template<std::size_t N>
+void bench()
+{
+   typedef small_object<N> T;
+   double const p = run<T>(plain_delete());
+   double const u = run<T>(unsized_delete());
+   double const s = run<T>(bml::default_delete<T>());
+   std::printf("%4u bytes: delete %6.2f ns, unsized %6.2f ns, default_delete %6.2f ns\n"
+              , unsigned(N), p, u, s);
+}
+
+int main()
+{
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   std::printf("sized deallocation: enabled\n");
+   #else
+   std::printf("sized deallocation: not supported, default_delete uses delete\n");
+   #endif
+   bench<8>();
+   bench<16>();
+   bench<32>();
+   bench<64>();
+   bench<128>();
+   return 0;
+}
@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Producer/consumer pipeline: one thread creates small objects, another one
+//destroys them. Compares unique_ptr with default_delete (the global allocator)
+//and make_unique_slab/slab_delete, whose remote frees go to a lock-free list
+//reclaimed in batches by the producer.
+
+#include <boost/move/slab_delete.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <cstddef>
+#include <cstdio>
+
+#if defined(BOOST_MOVE_HAS_SLAB_DELETE)
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace bml = ::boost::movelib;
+
+template<std::size_t N>
+struct small_object
+{
+   explicit small_object(std::size_t v)
+   {  data[0] = char(v);  }
+
+   char data[N];
+};
+
+static const std::size_t NumObjects = 2000000;
+static const std::size_t Capacity = 1024;
+
+//Single producer, single consumer ring of raw pointers
+template<class T>
+struct spsc_ring
+{
+   T *slots[Capacity];
+   std::atomic<std::size_t> head;
+   std::atomic<std::size_t> tail;
+
+   spsc_ring() : head(0), tail(0) {}
+
+   void push(T *p)
+   {
+      std::size_t const t = tail.load(std::memory_order_relaxed);
+      while(t - head.load(std::memory_order_acquire) == Capacity){
+         std::this_thread::yield();
+      }
+      slots[t % Capacity] = p;
+      tail.store(t + 1, std::memory_order_release);
+   }
+
+   T *pop()
+   {
+      std::size_t const h = head.load(std::memory_order_relaxed);
+      while(tail.load(std::memory_order_acquire) == h){
+         std::this_thread::yield();
+      }
+      T *const p = slots[h % Capacity];
+      head.store(h + 1, std::memory_order_release);
+      return p;
+   }
+};
+
+struct new_factory
+{
+   template<class T>
+   static bml::unique_ptr<T> make(std::size_t i)
+   {  return bml::unique_ptr<T>(new T(i));  }
+};
+
+struct slab_factory
+{
+   template<class T>
+   static bml::unique_ptr<T, bml::slab_delete<T> > make(std::size_t i)
+   {  return bml::make_unique_slab<T>(i);  }
+};
+
+//Returns nanoseconds per object
+template<class T, class Factory>
+double run()
+{
+   typedef decltype(Factory::template make<T>(0)) ptr_t;
+   typedef typename ptr_t::deleter_type deleter_t;
+   spsc_ring<T> ring;
+   std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+   std::thread consumer([&]{
+      std::size_t sum = 0;
+      for(std::size_t i = 0; i != NumObjects; ++i){
+         ptr_t p(ring.pop(), deleter_t());
+         sum += std::size_t(p->data[0]);
+      }
+      if(sum == std::size_t(-1))
+         std::printf("unexpected\n");
+   });
+   for(std::size_t i = 0; i != NumObjects; ++i){
+      ring.push(Factory::template make<T>(i).release());
+   }
+   consumer.join();
+   std::chrono::steady_clock::duration const d = std::chrono::steady_clock::now() - start;
+   return double(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count())/double(NumObjects);
+}
+
+template<std::size_t N>
+void bench()
+{
+   typedef small_object<N> T;
+   double const n = run<T, new_factory>();
+   double const s = run<T, slab_factory>();
+   std::printf("%4u bytes: new/delete %6.2f ns, slab %6.2f ns\n", unsigned(N), n, s);
+}
+
+int main()
+{
+   bench<16>();
+   bench<64>();
+   bench<256>();
+   return 0;
+}
+
+#else
+
+int main()
+{
+   std::printf("slab_delete: not supported by this compiler\n");
+   return 0;
+}
+
+#endif
@@ -19,9 +19,11 @@
 #include <boost/move/utility.hpp>
 #include <boost/move/iterator.hpp>
 #include <boost/detail/no_exceptions_support.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
 
 #include <algorithm> //copy, copy_backward
 #include <memory>    //uninitialized_copy
+#include <cstring>   //memset, memcpy
 
 namespace boost {
 
@@ -267,6 +269,212 @@ inline F copy_or_move(I f, I l, F r
    return std::copy(f, l, r);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//
+//                      uninitialized_value_construct_n
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/// @cond
+
+namespace move_detail {
+
+//True if F is a pointer to T and all-zero bytes are a value-initialized T
+template<class F>
+struct is_zero_initializable_ptr
+   : false_type
+{};
+
+template<class T>
+struct is_zero_initializable_ptr<T*>
+   : integral_constant<bool, ::boost::is_zero_initializable<T>::value>
+{};
+
+//True if F is a pointer to T and moved-from T objects can be value-initialized
+//overwriting them with zero bytes, without calling their destructors
+template<class F>
+struct is_zero_resettable_ptr
+   : false_type
+{};
+
+template<class T>
+struct is_zero_resettable_ptr<T*>
+   : integral_constant<bool, ::boost::is_zero_initializable<T>::value &&
+                             ::boost::has_trivial_destructor_after_move<T>::value>
+{};
+
+template<typename F, typename Size>
+F uninitialized_value_construct_n(F f, Size n, false_type)
+{
+   typedef typename std::iterator_traits<F>::value_type value_type;
+
+   F back = f;
+   BOOST_TRY{
+      for (; n > 0; --n, ++f) {
+         void * const addr = static_cast<void*>(::boost::move_detail::addressof(*f));
+         ::new(addr) value_type();
+      }
+   }
+   BOOST_CATCH(...){
+      for (; back != f; ++back){
+         back->~value_type();
+      }
+      BOOST_RETHROW;
+   }
+   BOOST_CATCH_END
+   return f;
+}
+
+template<typename T, typename Size>
+T *uninitialized_value_construct_n(T *f, Size n, true_type)
+{
+   if(n > 0){
+      std::memset(static_cast<void*>(f), 0, std::size_t(n)*sizeof(T));
+      f += n;
+   }
+   return f;
+}
+
+template<typename F>
+void reset_moved_from_range(F f, F l, false_type)
+{
+   typedef typename std::iterator_traits<F>::value_type value_type;
+   for (; f != l; ++f) {
+      *f = value_type();
+   }
+}
+
+template<typename T>
+void reset_moved_from_range(T *f, T *l, true_type)
+{
+   std::memset(static_cast<void*>(f), 0, std::size_t(l - f)*sizeof(T));
+}
+
+}  //namespace move_detail {
+
+/// @endcond
+
+//! <b>Effects</b>:
+//!   \code
+//!   for (; n > 0; ++first, --n)
+//!      new (static_cast<void*>(&*first))
+//!         typename iterator_traits<ForwardIterator>::value_type();
+//!   \endcode
+//!   If an exception is thrown, the already constructed elements are destroyed.
+//!
+//! <b>Returns</b>: first + n
+//!
+//! <b>Note</b>: If ForwardIterator is a pointer to T and <tt>is_zero_initializable<T>::value</tt>
+//!   is true, the elements are constructed with a single <tt>std::memset</tt>.
+template
+   <typename F,    // F models ForwardIterator
+    typename Size>
+inline F uninitialized_value_construct_n(F first, Size n)
+{
+   return ::boost::move_detail::uninitialized_value_construct_n
+      (first, n, ::boost::move_detail::is_zero_initializable_ptr<F>());
+}
+
+//! <b>Requires</b>: The elements in the range [first, last) are in the moved-from state.
+//!
+//! <b>Effects</b>:
+//!   \code
+//!   for (; first != last; ++first)
+//!      *first = typename iterator_traits<ForwardIterator>::value_type();
+//!   \endcode
+//!
+//! <b>Note</b>: If ForwardIterator is a pointer to T and both <tt>is_zero_initializable<T>::value</tt>
+//!   and <tt>has_trivial_destructor_after_move<T>::value</tt> are true, the range is overwritten
+//!   with a single <tt>std::memset</tt>, as moved-from elements own no resources.
+template
+   <typename F>   // F models ForwardIterator
+inline void reset_moved_from_range(F first, F last)
+{
+   ::boost::move_detail::reset_moved_from_range
+      (first, last, ::boost::move_detail::is_zero_resettable_ptr<F>());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                      uninitialized_move_if_noexcept
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/// @cond
+
+namespace move_detail {
+
+//True if I and F are pointers to the same trivially copyable T,
+//so that the range can be copied with memcpy
+template<class I, class F>
+struct is_memcpy_copyable_ptrs
+   : false_type
+{};
+
+template<class T>
+struct is_memcpy_copyable_ptrs<T*, T*>
+   : integral_constant<bool, ::boost::has_trivial_copy<T>::value>
+{};
+
+template<class T>
+struct is_memcpy_copyable_ptrs<const T*, T*>
+   : integral_constant<bool, ::boost::has_trivial_copy<T>::value>
+{};
+
+template<typename I, typename F>
+inline F uninitialized_move_if_noexcept_dispatch(I f, I l, F r, true_type)
+{
+   return ::boost::uninitialized_move(f, l, r);
+}
+
+template<typename I, typename F>
+inline F uninitialized_move_if_noexcept_dispatch(I f, I l, F r, false_type)
+{
+   return std::uninitialized_copy(f, l, r);
+}
+
+template<typename I, typename F>
+inline F uninitialized_move_if_noexcept(I f, I l, F r, false_type)
+{
+   typedef typename std::iterator_traits<I>::value_type input_value_type;
+   return uninitialized_move_if_noexcept_dispatch
+      (f, l, r, integral_constant<bool, is_nothrow_move_constructible_or_uncopyable<input_value_type>::value>());
+}
+
+template<typename I, typename T>
+inline T *uninitialized_move_if_noexcept(I f, I l, T *r, true_type)
+{
+   const std::size_t n = std::size_t(l - f);
+   if(n){
+      std::memcpy(static_cast<void*>(r), static_cast<const void*>(f), n*sizeof(T));
+      r += n;
+   }
+   return r;
+}
+
+}  //namespace move_detail {
+
+/// @endcond
+
+//! <b>Effects</b>: If the move constructor of the input value type can't throw or
+//!   the type is not copyable, <tt>uninitialized_move(first, last, result)</tt>. Otherwise
+//!   <tt>std::uninitialized_copy(first, last, result)</tt>, so the source range is left
+//!   unchanged if an exception is thrown. This is the range version of <tt>move_if_noexcept</tt>
+//!   needed to offer the strong exception guarantee when relocating the elements of a buffer.
+//!
+//! <b>Returns</b>: result + (last - first)
+//!
+//! <b>Note</b>: If both iterators are pointers to the same trivially copyable type
+//!   (<tt>has_trivial_copy<T>::value</tt> is true), the range is copied with a single <tt>std::memcpy</tt>.
+template
+   <typename I,   // I models InputIterator
+    typename F>   // F models ForwardIterator
+inline F uninitialized_move_if_noexcept(I first, I last, F result)
+{
+   return ::boost::move_detail::uninitialized_move_if_noexcept
+      (first, last, result, ::boost::move_detail::is_memcpy_copyable_ptrs<I, F>());
+}
+
 }  //namespace boost {
 
 #include <boost/move/detail/config_end.hpp>
@@ -0,0 +1,225 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_ALIGNED_DELETE_HPP_INCLUDED
+#define BOOST_MOVE_ALIGNED_DELETE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/detail/memory_utils.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>   //For std::size_t
+#include <new>       //For placement new
+
+//!\file
+//! Describes <tt>aligned_delete</tt> and the <tt>make_unique_aligned</tt> factories, which create
+//! arrays whose first element is aligned to a runtime alignment (e.g. 32 or 64 bytes for SIMD data),
+//! and <tt>assume_aligned</tt>, which passes a compile-time alignment hint to the optimizer.
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+template<class T>
+class aligned_delete;
+
+}  //namespace movelib {
+
+namespace move_upd {
+
+//Compile time switch to only accept arrays of unknown bound
+template<class T>
+struct aligned_unique_ptr_if
+{};
+
+template<class T>
+struct aligned_unique_ptr_if<T[]>
+{
+   typedef ::boost::movelib::unique_ptr<T[], ::boost::movelib::aligned_delete<T> > type;
+};
+
+//The alignment actually used to allocate an array of T
+template<class T>
+inline std::size_t aligned_array_alignment(std::size_t align) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(align && !(align & (align - 1u)));
+   const std::size_t min_align = alignment_of<T>::value > alignment_of<max_align_t>::value
+      ? alignment_of<T>::value : alignment_of<max_align_t>::value;
+   return align < min_align ? min_align : align;
+}
+
+template<class T>
+class aligned_array_construct_guard
+{
+   aligned_array_construct_guard(const aligned_array_construct_guard &);
+   aligned_array_construct_guard &operator=(const aligned_array_construct_guard &);
+
+   public:
+   aligned_array_construct_guard(std::size_t n, std::size_t align)
+      : m_p(static_cast<T*>(raw_aligned_allocate(array_allocation_size(n, sizeof(T)), align)))
+      , m_n(n), m_align(align), m_constructed(0)
+   {}
+
+   ~aligned_array_construct_guard()
+   {
+      if(m_p){
+         while(m_constructed){
+            m_p[--m_constructed].~T();
+         }
+         raw_aligned_deallocate(m_p, m_n*sizeof(T), m_align);
+      }
+   }
+
+   void construct(bool value_init)
+   {
+      for(; m_constructed != m_n; ++m_constructed){
+         void *const addr = static_cast<void*>(m_p + m_constructed);
+         value_init ? ::new(addr) T() : ::new(addr) T;
+      }
+   }
+
+   T *release()
+   {  T *const p = m_p;  m_p = 0;  return p;  }
+
+   private:
+   T *m_p;
+   std::size_t m_n;
+   std::size_t m_align;
+   std::size_t m_constructed;
+};
+
+template<class T>
+inline typename aligned_unique_ptr_if<T>::type
+   make_unique_aligned_impl(std::size_t n, std::size_t align, bool value_init)
+{
+   typedef typename bmupmu::remove_extent<T>::type U;
+   align = aligned_array_alignment<U>(align);
+   aligned_array_construct_guard<U> g(n, align);
+   g.construct(value_init);
+   return typename aligned_unique_ptr_if<T>::type(g.release(), ::boost::movelib::aligned_delete<U>(n, align));
+}
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>aligned_delete</tt> is a deleter for <tt>unique_ptr<T[]></tt> that stores
+//!the number of elements and the alignment of an array created by <tt>make_unique_aligned</tt>.
+//!It destroys the elements in reverse order and frees the storage with the aligned deallocation
+//!function, passing its size if sized deallocation is supported by the compiler.
+//!
+//! \tparam T The element type of the array.
+template <class T>
+class aligned_delete
+{
+   public:
+   //! <b>Effects</b>: Constructs a deleter for an empty array.
+   //!
+   //! <b>Postcondition</b>: <tt>size() == 0</tt>.
+   aligned_delete() BOOST_NOEXCEPT
+      : m_size(0), m_align(bmupd::alignment_of<bmupd::max_align_t>::value)
+   {}
+
+   //! <b>Effects</b>: Constructs a deleter for an array of n elements allocated with alignment align.
+   //!
+   //! <b>Postcondition</b>: <tt>size() == n && alignment() == align</tt>.
+   aligned_delete(std::size_t n, std::size_t align) BOOST_NOEXCEPT
+      : m_size(n), m_align(align)
+   {}
+
+   //! <b>Returns</b>: The number of elements of the array this deleter will destroy.
+   //!
+   std::size_t size() const BOOST_NOEXCEPT
+   {  return m_size;  }
+
+   //! <b>Returns</b>: The alignment of the array this deleter will destroy.
+   //!
+   std::size_t alignment() const BOOST_NOEXCEPT
+   {  return m_align;  }
+
+   //! <b>Effects</b>: Destroys the size() elements pointed by p in reverse order
+   //!   and deallocates the storage.
+   void operator()(T *p) const BOOST_NOEXCEPT
+   {
+      //T must be a complete type
+      BOOST_STATIC_ASSERT(sizeof(T) > 0);
+      for(std::size_t n = m_size; n; ){
+         p[--n].~T();
+      }
+      bmupd::raw_aligned_deallocate
+         (const_cast<void*>(static_cast<const volatile void*>(p)), m_size*sizeof(T), m_align);
+   }
+
+   private:
+   std::size_t m_size;
+   std::size_t m_align;
+};
+
+//! <b>Requires</b>: align is a power of two.
+//!
+//! <b>Effects</b>: Allocates storage for n elements of type <tt>remove_extent_t<T></tt> aligned to
+//!   align bytes, or to the alignment of the elements or of <tt>max_align_t</tt> if greater,
+//!   and value-initializes the elements. If the construction of an element throws, already constructed
+//!   elements are destroyed and the storage is deallocated.
+//!
+//! <b>Returns</b>: A <tt>unique_ptr<T, aligned_delete<remove_extent_t<T> > ></tt> owning the new elements.
+//!
+//! <b>Remarks</b>: This function shall not participate in overload resolution unless T is an array of
+//!   unknown bound.
+template<class T>
+inline BOOST_MOVE_DOC1ST(unique_ptr<T BOOST_MOVE_I aligned_delete<remove_extent_t<T> > >,
+   typename ::boost::move_upd::aligned_unique_ptr_if<T>::type)
+      make_unique_aligned(std::size_t n, std::size_t align)
+{  return ::boost::move_upd::make_unique_aligned_impl<T>(n, align, true);  }
+
+//! <b>Effects</b>: Same as <tt>make_unique_aligned</tt>, but the elements are default-initialized.
+//!
+template<class T>
+inline BOOST_MOVE_DOC1ST(unique_ptr<T BOOST_MOVE_I aligned_delete<remove_extent_t<T> > >,
+   typename ::boost::move_upd::aligned_unique_ptr_if<T>::type)
+      make_unique_aligned_definit(std::size_t n, std::size_t align)
+{  return ::boost::move_upd::make_unique_aligned_impl<T>(n, align, false);  }
+
+//! <b>Requires</b>: N is a power of two and p is aligned to N bytes.
+//!
+//! <b>Returns</b>: p. Where supported, the compiler is told that the result is aligned to N bytes,
+//!   so that loops over the pointed elements can be vectorized with aligned loads and stores.
+template<std::size_t N, class T>
+inline T *assume_aligned(T *p) BOOST_NOEXCEPT
+{
+   BOOST_STATIC_ASSERT(( N && !(N & (N - 1u)) ));
+   BOOST_ASSERT(!(reinterpret_cast<std::size_t>(p) & (N - 1u)));
+   return static_cast<T*>(BOOST_MOVE_ASSUME_ALIGNED(p, N));
+}
+
+//! <b>Requires</b>: N is a power of two not greater than <tt>p.get_deleter().alignment()</tt>.
+//!
+//! <b>Returns</b>: <tt>assume_aligned<N>(p.get())</tt>.
+template<std::size_t N, class T>
+inline T *aligned_data(const unique_ptr<T[], aligned_delete<T> > &p) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(!p || N <= p.get_deleter().alignment());
+   return assume_aligned<N>(p.get());
+}
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_ALIGNED_DELETE_HPP_INCLUDED
@@ -17,6 +17,7 @@
 #define BOOST_MOVE_CORE_HPP
 
 #include <boost/move/detail/config_begin.hpp>
+#include <boost/move/trace.hpp>
 
 //boost_move_no_copy_constructor_or_assign typedef
 //used to detect noncopyable types for other Boost libraries.
@@ -40,6 +41,37 @@
    //
 #endif   //BOOST_NO_CXX11_DELETED_FUNCTIONS
 
+//boost_move_nothrow_move_t typedef used by has_nothrow_move to detect types
+//marked with the _NOTHROW macros. It names the marked type so that it's
+//not inherited by derived classes, whose moves might throw.
+#define BOOST_MOVE_IMPL_NOTHROW_MOVE(TYPE) \
+   public:\
+   typedef TYPE boost_move_nothrow_move_t;\
+   private:\
+//
+
+//! This macro declares that a moved-from object of type TYPE owns no resources,
+//! so that <tt>has_trivial_destructor_after_move</tt> is true for the type and containers
+//! can skip destroying moved-from elements. It can be used with any of the movable class
+//! macros and, like them, it must be placed in the class definition. It's not inherited
+//! by derived classes.
+#define BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(TYPE) \
+   public:\
+   typedef TYPE boost_move_trivial_destructor_after_move_t;\
+   private:\
+//
+
+//! This macro declares that an object of type TYPE whose bytes are all zero is
+//! equivalent to a value-initialized object, so that <tt>is_zero_initializable</tt>
+//! is true for the type and arrays of TYPE can be value-initialized with <tt>std::calloc</tt>
+//! or <tt>std::memset</tt>. It must be placed in the class definition and it's not inherited
+//! by derived classes.
+#define BOOST_MOVE_ZERO_INITIALIZABLE(TYPE) \
+   public:\
+   typedef TYPE boost_move_zero_initializable_t;\
+   private:\
+//
+
 #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_MOVE_DOXYGEN_INVOKED)
 
    #include <boost/move/detail/meta_utils.hpp>
@@ -201,7 +233,7 @@
       BOOST_MOVE_IMPL_NO_COPY_CTOR_OR_ASSIGN(TYPE)\
       public:\
       operator ::boost::rv<TYPE>&() \
-      {  return *static_cast< ::boost::rv<TYPE>* >(this);  }\
+      {  BOOST_MOVE_TRACE_RVALUE_CAST(TYPE); return *static_cast< ::boost::rv<TYPE>* >(this);  }\
       operator const ::boost::rv<TYPE>&() const \
       {  return *static_cast<const ::boost::rv<TYPE>* >(this);  }\
       private:\
@@ -213,13 +245,17 @@
    //
    //////////////////////////////////////////////////////////////////////////////
 
+   //Non-const lvalues select operator=(TYPE &), which copies. Non-const temporaries can't
+   //bind to TYPE &, and the non-const conversion to rv<TYPE>& is preferred to the const one,
+   //so "t = rvalue_func();" selects the move assignment (see test/copy_move_optimization.cpp).
    #define BOOST_COPYABLE_AND_MOVABLE(TYPE)\
       public:\
       TYPE& operator=(TYPE &t)\
-      {  this->operator=(static_cast<const ::boost::rv<TYPE> &>(const_cast<const TYPE &>(t))); return *this;}\
+      {  BOOST_MOVE_TRACE_LVALUE_COPY_ASSIGN(TYPE);\
+         this->operator=(static_cast<const ::boost::rv<TYPE> &>(const_cast<const TYPE &>(t))); return *this;}\
       public:\
       operator ::boost::rv<TYPE>&() \
-      {  return *static_cast< ::boost::rv<TYPE>* >(this);  }\
+      {  BOOST_MOVE_TRACE_RVALUE_CAST(TYPE); return *static_cast< ::boost::rv<TYPE>* >(this);  }\
       operator const ::boost::rv<TYPE>&() const \
       {  return *static_cast<const ::boost::rv<TYPE>* >(this);  }\
       private:\
@@ -228,12 +264,22 @@
    #define BOOST_COPYABLE_AND_MOVABLE_ALT(TYPE)\
       public:\
       operator ::boost::rv<TYPE>&() \
-      {  return *static_cast< ::boost::rv<TYPE>* >(this);  }\
+      {  BOOST_MOVE_TRACE_RVALUE_CAST(TYPE); return *static_cast< ::boost::rv<TYPE>* >(this);  }\
       operator const ::boost::rv<TYPE>&() const \
       {  return *static_cast<const ::boost::rv<TYPE>* >(this);  }\
       private:\
    //
 
+   #define BOOST_MOVABLE_BUT_NOT_COPYABLE_NOTHROW(TYPE)\
+      BOOST_MOVABLE_BUT_NOT_COPYABLE(TYPE)\
+      BOOST_MOVE_IMPL_NOTHROW_MOVE(TYPE)\
+   //
+
+   #define BOOST_COPYABLE_AND_MOVABLE_NOTHROW(TYPE)\
+      BOOST_COPYABLE_AND_MOVABLE(TYPE)\
+      BOOST_MOVE_IMPL_NOTHROW_MOVE(TYPE)\
+   //
+
    namespace boost{
    namespace move_detail{
 
@@ -286,6 +332,23 @@
    //
    #endif   //#if !defined(BOOST_MOVE_DOXYGEN_INVOKED)
 
+   //! This macro marks a type as movable but not copyable, like BOOST_MOVABLE_BUT_NOT_COPYABLE,
+   //! and declares that its move constructor and assignment don't throw, so that
+   //! <tt>has_nothrow_move</tt> is true for the type also in compilers without <tt>noexcept</tt>.
+   #define BOOST_MOVABLE_BUT_NOT_COPYABLE_NOTHROW(TYPE)\
+      BOOST_MOVABLE_BUT_NOT_COPYABLE(TYPE)\
+      BOOST_MOVE_IMPL_NOTHROW_MOVE(TYPE)\
+   //
+
+   //! This macro marks a type as copyable and movable, like BOOST_COPYABLE_AND_MOVABLE,
+   //! and declares that its move constructor and assignment don't throw, so that
+   //! <tt>has_nothrow_move</tt> is true for the type and <tt>move_if_noexcept</tt> moves it
+   //! also in compilers without <tt>noexcept</tt>.
+   #define BOOST_COPYABLE_AND_MOVABLE_NOTHROW(TYPE)\
+      BOOST_COPYABLE_AND_MOVABLE(TYPE)\
+      BOOST_MOVE_IMPL_NOTHROW_MOVE(TYPE)\
+   //
+
    namespace boost {
 
    //!This trait yields to a compile-time true boolean if T was marked as
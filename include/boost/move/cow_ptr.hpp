@@ -0,0 +1,361 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_COW_PTR_HPP_INCLUDED
+#define BOOST_MOVE_COW_PTR_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/move/detail/unique_ptr_meta_utils.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/move/default_delete.hpp>
+#include <boost/detail/atomic_count.hpp>
+#include <boost/assert.hpp>
+
+//!\file
+//! Describes <tt>cow_ptr</tt>, a copy-on-write owner of a shared value, and the
+//! <tt>make_cow</tt> factory.
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace move_upd {
+
+//////////////////////////////////////
+//             cow_node
+//////////////////////////////////////
+
+//The shared value and its reference count, allocated in a single block
+template<class T>
+struct cow_node
+{
+   private:
+   cow_node(const cow_node &);
+   cow_node &operator=(const cow_node &);
+
+   public:
+   #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+   template<class... Args>
+   explicit cow_node(BOOST_FWD_REF(Args)... args)
+      : count(1), value(::boost::forward<Args>(args)...)
+   {}
+
+   #else
+
+   cow_node()
+      : count(1), value()
+   {}
+
+   #define BOOST_PP_LOCAL_MACRO(n) \
+   template<BOOST_PP_ENUM_PARAMS(n, class P)> \
+   explicit cow_node(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_LIST, _)) \
+      : count(1), value(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)) \
+   {} \
+   //!
+
+   #define BOOST_PP_LOCAL_LIMITS (1, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+   #endif
+
+   ::boost::detail::atomic_count count;
+   T value;
+};
+
+template<class T>
+struct cow_factory;
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>cow_ptr</tt> owns a value of type T shared by all its copies:
+//!copying a <tt>cow_ptr</tt> increments an atomic reference count instead of copying the value.
+//!Read access is through <tt>get()</tt>, <tt>operator*</tt> and <tt>operator-></tt>, which only give
+//!const access. Write access is through <tt>write()</tt>, which copies the value first if it is
+//!shared (copy-on-write), so that the modification is not seen by the other copies.
+//!
+//!Moves transfer the value without touching the reference count.
+//!
+//!As with <tt>shared_ptr</tt>, distinct <tt>cow_ptr</tt> objects sharing a value can be copied, destroyed
+//!and written in different threads, but a single <tt>cow_ptr</tt> object can't be accessed concurrently
+//!if one of the accesses is a modification.
+//!
+//! \tparam T The type of the value. Must be copy constructible.
+template <class T>
+class cow_ptr
+{
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   public:
+   cow_ptr(const cow_ptr&);
+   cow_ptr& operator=(const cow_ptr&);
+   private:
+   #else
+   BOOST_COPYABLE_AND_MOVABLE(cow_ptr)
+   BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(cow_ptr)
+   BOOST_MOVE_ZERO_INITIALIZABLE(cow_ptr)
+   typedef bmupd::cow_node<T> node_t;
+   #endif
+
+   public:
+   typedef T         element_type;
+
+   //! <b>Effects</b>: Constructs an empty cow_ptr.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr</tt>.
+   cow_ptr() BOOST_NOEXCEPT
+      : m_p()
+   {}
+
+   //! <b>Effects</b>: Same as <tt>cow_ptr()</tt> (default constructor).
+   //!
+   cow_ptr(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+      : m_p()
+   {}
+
+   //! <b>Effects</b>: Owns a new value copy constructed from t.
+   //!
+   explicit cow_ptr(const T &t)
+      : m_p(new node_t(t))
+   {}
+
+   //! <b>Effects</b>: Owns a new value move constructed from t.
+   //!
+   explicit cow_ptr(BOOST_RV_REF(T) t)
+      : m_p(new node_t(::boost::move(t)))
+   {}
+
+   //! <b>Effects</b>: Shares the value of x, if any, incrementing its reference count.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == x.get()</tt>.
+   cow_ptr(const cow_ptr &x) BOOST_NOEXCEPT
+      : m_p(x.m_p)
+   {
+      if(m_p)  ++m_p->count;
+   }
+
+   //! <b>Effects</b>: Transfers the value from x to *this. The reference count is not modified.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   cow_ptr(BOOST_RV_REF(cow_ptr) x) BOOST_NOEXCEPT
+      : m_p(x.m_p)
+   {  x.m_p = 0;  }
+
+   //! <b>Effects</b>: Releases the value, destroying it if this was the last owner.
+   //!
+   ~cow_ptr()
+   {  release(m_p);  }
+
+   //! <b>Effects</b>: Releases the value and shares the value of x, if any.
+   //!
+   cow_ptr& operator=(BOOST_COPY_ASSIGN_REF(cow_ptr) x) BOOST_NOEXCEPT
+   {
+      node_t *const p = x.m_p;
+      if(p)  ++p->count;
+      release(m_p);
+      m_p = p;
+      return *this;
+   }
+
+   //! <b>Effects</b>: Releases the value and transfers the value from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   cow_ptr& operator=(BOOST_RV_REF(cow_ptr) x) BOOST_NOEXCEPT
+   {
+      if(this != &x){
+         release(m_p);
+         m_p = x.m_p;
+         x.m_p = 0;
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: <tt>reset()</tt>.
+   //!
+   cow_ptr& operator=(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+   {  this->reset(); return *this;  }
+
+   //! <b>Returns</b>: A pointer to the value or nullptr if empty.
+   //!
+   const T *get() const BOOST_NOEXCEPT
+   {  return m_p ? &m_p->value : 0;  }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>*get()</tt>.
+   const T &operator*() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(m_p);
+      return m_p->value;
+   }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>get()</tt>.
+   const T *operator->() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(m_p);
+      return &m_p->value;
+   }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Effects</b>: If the value is shared with other cow_ptr objects, replaces it with
+   //!   a copy, so that *this is the only owner. If the copy throws, *this is not modified.
+   //!
+   //! <b>Returns</b>: A modifiable reference to the value.
+   //!
+   //! <b>Postcondition</b>: <tt>unique()</tt>.
+   T &write()
+   {
+      BOOST_ASSERT(m_p);
+      if(m_p->count != 1){
+         node_t *const p = new node_t(static_cast<const T&>(m_p->value));
+         release(m_p);
+         m_p = p;
+      }
+      return m_p->value;
+   }
+
+   //! <b>Returns</b>: The number of cow_ptr objects sharing the value, or 0 if empty.
+   //!
+   long use_count() const BOOST_NOEXCEPT
+   {  return m_p ? long(m_p->count) : 0;  }
+
+   //! <b>Returns</b>: <tt>use_count() == 1</tt>.
+   //!
+   bool unique() const BOOST_NOEXCEPT
+   {  return this->use_count() == 1;  }
+
+   #ifdef BOOST_MOVE_DOXYGEN_INVOKED
+   //! <b>Returns</b>: Returns: get() != nullptr.
+   //!
+   explicit operator bool
+   #else
+   operator bmupd::explicit_bool_arg
+   #endif
+      ()const BOOST_NOEXCEPT
+   {
+      return m_p
+         ? &bmupd::bool_conversion::for_bool
+         : bmupd::explicit_bool_arg(0);
+   }
+
+   //! <b>Effects</b>: Releases the value, destroying it if this was the last owner.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr</tt>.
+   void reset() BOOST_NOEXCEPT
+   {
+      release(m_p);
+      m_p = 0;
+   }
+
+   //! <b>Effects</b>: Exchanges the values of *this and x. Reference counts are not modified.
+   //!
+   void swap(cow_ptr &x) BOOST_NOEXCEPT
+   {
+      node_t *const tmp = m_p;
+      m_p = x.m_p;
+      x.m_p = tmp;
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   template<class U>
+   friend struct bmupd::cow_factory;
+
+   explicit cow_ptr(node_t *p) BOOST_NOEXCEPT
+      : m_p(p)
+   {}
+
+   static void release(node_t *p) BOOST_NOEXCEPT
+   {
+      if(p && --p->count == 0){
+         delete p;
+      }
+   }
+
+   node_t *m_p;
+   #endif
+};
+
+//! <b>Effects</b>: Calls <tt>x.swap(y)</tt>.
+//!
+template <class T>
+inline void swap(cow_ptr<T> &x, cow_ptr<T> &y) BOOST_NOEXCEPT
+{  x.swap(y); }
+
+//! <b>Returns</b>: <tt>x.get() == y.get()</tt>, that is, true if x and y share the same value.
+//!
+template <class T>
+inline bool operator==(const cow_ptr<T> &x, const cow_ptr<T> &y) BOOST_NOEXCEPT
+{  return x.get() == y.get(); }
+
+//! <b>Returns</b>: <tt>x.get() != y.get()</tt>.
+//!
+template <class T>
+inline bool operator!=(const cow_ptr<T> &x, const cow_ptr<T> &y) BOOST_NOEXCEPT
+{  return x.get() != y.get(); }
+
+}  //namespace movelib {
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace move_upd {
+
+template<class T>
+struct cow_factory
+{
+   typedef ::boost::movelib::cow_ptr<T> cow_t;
+
+   static cow_t make(cow_node<T> *p) BOOST_NOEXCEPT
+   {  return cow_t(p);  }
+};
+
+}  //namespace move_upd {
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace movelib {
+
+#if defined(BOOST_MOVE_DOXYGEN_INVOKED) || !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+//! <b>Returns</b>: A cow_ptr owning a new value constructed with <tt>T(std::forward<Args>(args)...)</tt>.
+//!   The value and its reference count are allocated in a single block.
+template<class T, class... Args>
+inline cow_ptr<T> make_cow(BOOST_FWD_REF(Args)... args)
+{  return bmupd::cow_factory<T>::make(new bmupd::cow_node<T>(::boost::forward<Args>(args)...));  }
+
+#else
+
+   #define BOOST_PP_LOCAL_MACRO(n) \
+   template<class T BOOST_PP_ENUM_TRAILING_PARAMS(n, class P) > \
+   inline cow_ptr<T> make_cow(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_LIST, _)) \
+   {  return bmupd::cow_factory<T>::make(new bmupd::cow_node<T>(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)));  } \
+   //!
+
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+#endif
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_COW_PTR_HPP_INCLUDED
@@ -19,6 +19,10 @@
 
 #include <cstddef>   //For std::size_t,std::nullptr_t
 
+#if defined(BOOST_MOVE_USE_SIZED_DEALLOCATION) && defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+#include <new>       //For sized operator delete
+#endif
+
 //!\file
 //! Describes the default deleter (destruction policy) of <tt>unique_ptr</tt>: <tt>default_delete</tt>.
 
@@ -49,6 +53,14 @@ struct enable_def_del
    : bmupmu::enable_if_c<def_del_compatible_cond<U, T>::value, Type>
 {};
 
+//Deleting a pointer to T itself is by far the most common case,
+//avoid instantiating the convertibility checks
+template<class T, class Type>
+struct enable_def_del<T, T, Type>
+{
+   typedef Type type;
+};
+
 ////////////////////////////////////////
 ////        enable_defdel_call
 ////////////////////////////////////////
@@ -87,6 +99,77 @@ typedef int bool_conversion::* explicit_bool_arg;
    typedef int (bool_conversion::*nullptr_type)();
 #endif
 
+////////////////////////////////////////
+////     default_delete disposal
+////////////////////////////////////////
+
+#if defined(BOOST_MOVE_USE_SIZED_DEALLOCATION) && defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
+//Detects class-specific deallocation functions, which must not be bypassed
+template<class T>
+class has_member_operator_delete
+{
+   typedef char true_t;
+   class false_t { char dummy[2]; };
+   template<class U> static true_t  dispatch(decltype(U::operator delete(static_cast<void*>(0)))*, int);
+   template<class U> static true_t  dispatch(decltype(U::operator delete(static_cast<void*>(0), std::size_t(0)))*, long);
+   template<class U> static false_t dispatch(...);
+   public:
+   static const bool value = sizeof(dispatch<T>(0, 0)) == sizeof(true_t);
+};
+
+//The size of the object can be known statically if the dynamic type
+//is T (T is final or deleting through T* requires T to be the dynamic type)
+//and there is no class-specific operator delete
+template<class T>
+struct use_sized_delete
+{
+   static const bool value = !bmupmu::is_array<T>::value &&
+                             !has_member_operator_delete<T>::value &&
+                             (bmupmu::is_final<T>::value || !bmupmu::has_virtual_destructor<T>::value);
+};
+
+#else
+
+template<class T>
+struct use_sized_delete
+{
+   static const bool value = false;
+};
+
+#endif   //#if defined(BOOST_MOVE_USE_SIZED_DEALLOCATION) && defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
+template<class T, bool = use_sized_delete<typename bmupmu::remove_cv<T>::type>::value>
+struct def_del_dispose
+{
+   typedef typename bmupmu::remove_extent<T>::type element_type;
+
+   static void call(element_type *p) BOOST_NOEXCEPT
+   {  bmupmu::is_array<T>::value ? delete [] p : delete p;   }
+};
+
+#if defined(BOOST_MOVE_USE_SIZED_DEALLOCATION) && defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
+template<class T>
+struct def_del_dispose<T, true>
+{
+   static void call(T *p) BOOST_NOEXCEPT
+   {
+      p->~T();
+      void *const raw = const_cast<void*>(static_cast<const volatile void*>(p));
+      #if defined(BOOST_MOVE_HAS_ALIGNED_NEW)
+      //Over-aligned objects were allocated with operator new(std::size_t, std::align_val_t)
+      if(alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+         ::operator delete(raw, sizeof(T), std::align_val_t(alignof(T)));
+         return;
+      }
+      #endif
+      ::operator delete(raw, sizeof(T));
+   }
+};
+
+#endif   //#if defined(BOOST_MOVE_USE_SIZED_DEALLOCATION) && defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
 }  //namespace move_upd {
 
 namespace movelib {
@@ -155,6 +238,13 @@ struct default_delete
    //! <b>Effects</b>: if T is not an array type, calls <tt>delete</tt> on static_cast<T*>(ptr),
    //!   otherwise calls <tt>delete[]</tt> on static_cast<remove_extent<T>::type*>(ptr).
    //!
+   //!   If <tt>BOOST_MOVE_USE_SIZED_DEALLOCATION</tt> is defined, the compiler supports C++14 sized deallocation,
+   //!   T is not an array type, T has no class-specific <tt>operator delete</tt> and T is final or has no virtual
+   //!   destructor, the object is destroyed explicitly and its storage is freed calling
+   //!   <tt>::operator delete(p, sizeof(T))</tt>, so that the memory allocator can skip the size lookup.
+   //!   If the compiler supports C++17 aligned allocation and T is over-aligned,
+   //!   <tt>::operator delete(p, sizeof(T), std::align_val_t(alignof(T)))</tt> is called instead.
+   //!
    //! <b>Remarks</b>: If U is an incomplete type, the program is ill-formed.
    //!   This operator shall not participate in overload resolution unless:
    //!      - T is not an array type and U* is convertible to T*, OR
@@ -170,7 +260,7 @@ struct default_delete
       //and T has no virtual destructor, then you have a problem
       BOOST_STATIC_ASSERT(( !::boost::move_upmu::missing_virtual_destructor<default_delete, U>::value ));
       element_type * const p = static_cast<element_type*>(ptr);
-      bmupmu::is_array<T>::value ? delete [] p : delete p;
+      bmupd::def_del_dispose<T>::call(p);
    }
 
    //! <b>Effects</b>: Same as <tt>(*this)(static_cast<element_type*>(nullptr))</tt>.
@@ -180,6 +270,31 @@ struct default_delete
 };
 
 }  //namespace movelib {
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+template <class T>
+struct has_trivial_destructor_after_move;
+
+template <class T>
+struct is_zero_initializable;
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+//!default_delete is stateless so it's never necessary to destroy it, even in compilers
+//!that can't detect trivial destructors.
+template <class T>
+struct has_trivial_destructor_after_move< ::boost::movelib::default_delete<T> >
+{
+   static const bool value = true;
+};
+
+//!default_delete is stateless so it's zero-initializable, even in compilers
+//!that can't detect trivial constructors.
+template <class T>
+struct is_zero_initializable< ::boost::movelib::default_delete<T> >
+{
+   static const bool value = true;
+};
+
 }  //namespace boost{
 
 #include <boost/move/detail/config_end.hpp>
@@ -0,0 +1,402 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DEFERRED_DELETE_HPP_INCLUDED
+#define BOOST_MOVE_DEFERRED_DELETE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/default_delete.hpp>
+#include <boost/move/detail/retired_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
+
+#include <cstddef>   //For std::size_t
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+   #define BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL thread_local
+   #define BOOST_MOVE_DEFERRED_DELETE_AUTO_FLUSH
+#elif defined(BOOST_MSVC)
+   #define BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+   #define BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL __thread
+#endif
+
+#if  !defined(BOOST_NO_CXX11_THREAD_LOCAL)            && \
+     !defined(BOOST_NO_CXX11_HDR_THREAD)              && \
+     !defined(BOOST_NO_CXX11_HDR_MUTEX)               && \
+     !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)  && \
+     !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   #define BOOST_MOVE_HAS_DEFERRED_RECLAIMER
+   #include <thread>
+   #include <mutex>
+   #include <condition_variable>
+   #include <vector>
+   #include <utility>
+#endif
+
+//!\file
+//! Describes <tt>deferred_delete</tt>, a deleter for <tt>unique_ptr</tt> that moves
+//! the destruction of objects out of the calling code, and <tt>deferred_reclaimer</tt>,
+//! a background thread that destroys the objects retired by other threads.
+
+//! Number of objects a thread can retire before the retire buffer is drained.
+#ifndef BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE
+   #define BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE 256
+#endif
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace move_upd {
+
+//////////////////////////////////////
+//           retire_buffer
+//////////////////////////////////////
+
+//POD so that it can be placed in compiler-specific thread local
+//storage that does not support non-trivial constructors or destructors
+struct retire_buffer
+{
+   std::size_t size;
+   bool draining;
+   retired_ptr items[BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE];
+
+   //Destroys objects until the buffer is empty. Objects retired by the
+   //destructors of the drained ones are also destroyed. Items are popped
+   //one by one so that freed slots can be reused by those nested retirements.
+   void drain() BOOST_NOEXCEPT
+   {
+      if(draining)
+         return;
+      draining = true;
+      while(size){
+         retired_ptr const r = items[--size];
+         r.destroy(r.ptr);
+      }
+      draining = false;
+   }
+
+   void handoff_or_drain() BOOST_NOEXCEPT;
+
+   void push(const retired_ptr &r) BOOST_NOEXCEPT
+   {
+      if(size == BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE){
+         //A nested retirement can't be buffered while draining a full buffer
+         if(draining){
+            r.destroy(r.ptr);
+            return;
+         }
+         this->handoff_or_drain();
+      }
+      items[size++] = r;
+   }
+};
+
+#if defined(BOOST_MOVE_DEFERRED_DELETE_AUTO_FLUSH)
+
+//Drains the buffer when the thread exits
+struct retire_buffer_holder
+{
+   retire_buffer buf;
+
+   retire_buffer_holder() BOOST_NOEXCEPT
+   {  buf.size = 0; buf.draining = false;  }
+
+   ~retire_buffer_holder()
+   {  buf.drain();  }
+};
+
+inline retire_buffer &thread_retire_buffer() BOOST_NOEXCEPT
+{
+   static thread_local retire_buffer_holder holder;
+   return holder.buf;
+}
+
+#elif defined(BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL)
+
+inline retire_buffer &thread_retire_buffer() BOOST_NOEXCEPT
+{
+   //Zero-initialized
+   static BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL retire_buffer buf;
+   return buf;
+}
+
+#endif   //#if defined(BOOST_MOVE_DEFERRED_DELETE_AUTO_FLUSH)
+
+#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+
+//////////////////////////////////////
+//        reclaimer_registry
+//////////////////////////////////////
+struct reclaimer_queue
+{
+   typedef std::vector<retired_ptr> batch_t;
+
+   std::vector<batch_t> batches;
+   bool stop;
+   std::condition_variable cond;
+   std::thread thread;
+};
+
+//The mutex protects both the registration of the reclaimer
+//and its queue of batches, so a retiring thread can never
+//hand off a batch to a reclaimer that is being destroyed.
+template<class Dummy>
+struct reclaimer_registry
+{
+   static std::mutex mutex;
+   static reclaimer_queue *current;
+};
+
+template<class Dummy>
+std::mutex reclaimer_registry<Dummy>::mutex;
+
+template<class Dummy>
+reclaimer_queue *reclaimer_registry<Dummy>::current;
+
+typedef reclaimer_registry<void> reclaimer_registry_t;
+
+inline void retire_buffer::handoff_or_drain() BOOST_NOEXCEPT
+{
+   bool handed_off = false;
+   BOOST_TRY{
+      reclaimer_queue::batch_t batch(items, items + size);
+      std::lock_guard<std::mutex> lock(reclaimer_registry_t::mutex);
+      reclaimer_queue *const q = reclaimer_registry_t::current;
+      if(q){
+         q->batches.push_back(reclaimer_queue::batch_t());
+         q->batches.back().swap(batch);
+         q->cond.notify_one();
+         handed_off = true;
+      }
+   }
+   BOOST_CATCH(...){
+   }
+   BOOST_CATCH_END
+   if(handed_off){
+      size = 0;
+   }
+   else{
+      this->drain();
+   }
+}
+
+#else
+
+inline void retire_buffer::handoff_or_drain() BOOST_NOEXCEPT
+{  this->drain();  }
+
+#endif   //#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>deferred_delete</tt> is a deleter for <tt>unique_ptr</tt>
+//!that does not destroy the object inline. The pointer is pushed to a retire buffer
+//!owned by the calling thread and the objects are destroyed later, in batches:
+//!   - when the buffer is full (BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE objects),
+//!   - when <tt>flush()</tt> is called,
+//!   - when the thread exits (only if the compiler supports C++11 <tt>thread_local</tt>).
+//!
+//!If a <tt>deferred_reclaimer</tt> is alive, full buffers are handed off to its
+//!background thread instead of being drained by the retiring thread.
+//!
+//!Objects are destroyed through <tt>default_delete<T></tt>. Objects retired by the
+//!destructors of deferred objects are also deferred and destroyed in the same drain.
+//!
+//!If the compiler only offers POD thread local storage (C++03 compilers) the retire buffer
+//!is not drained on thread exit, so threads must call <tt>flush()</tt> before exiting.
+//!If no thread local storage is available at all, objects are destroyed inline.
+//!
+//! \tparam T The type to be deleted. It may be an incomplete type
+template <class T>
+struct deferred_delete
+{
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   typedef typename bmupmu::remove_extent<T>::type element_type;
+   #endif
+
+   //! Default constructor.
+   //!
+   deferred_delete() BOOST_NOEXCEPT
+   {}
+
+   //! <b>Effects</b>: Constructs a deferred_delete object from another <tt>deferred_delete<U></tt> object.
+   //!
+   //! <b>Remarks</b>: This constructor shall not participate in overload resolution unless:
+   //!   - If T is not an array type and U* is implicitly convertible to T*.
+   //!   - If T is an array type and U* is a more CV qualified pointer to remove_extent<T>::type.
+   template <class U>
+   deferred_delete(const deferred_delete<U>&
+      BOOST_MOVE_DOCIGN(BOOST_MOVE_I typename bmupd::enable_def_del<U BOOST_MOVE_I T>::type* =0)
+      ) BOOST_NOEXCEPT
+   {
+      //If T is not an array type, U derives from T
+      //and T has no virtual destructor, then you have a problem
+      BOOST_STATIC_ASSERT(( !::boost::move_upmu::missing_virtual_destructor<default_delete<T>, U>::value ));
+   }
+
+   //! <b>Effects</b>: If ptr is not null, retires static_cast<element_type*>(ptr) so that it is later destroyed
+   //!   by <tt>default_delete<T></tt>.
+   //!
+   //! <b>Remarks</b>: If U is an incomplete type, the program is ill-formed.
+   //!   This operator shall not participate in overload resolution unless:
+   //!      - T is not an array type and U* is convertible to T*, OR
+   //!      - T is an array type, and remove_cv<U>::type is the same type as
+   //!         remove_cv<remove_extent<T>::type>::type and U* is convertible to remove_extent<T>::type*.
+   template <class U>
+   BOOST_MOVE_DOC1ST(void, typename bmupd::enable_defdel_call<U BOOST_MOVE_I T BOOST_MOVE_I void>::type)
+      operator()(U* ptr) const BOOST_NOEXCEPT
+   {
+      //U must be a complete type
+      BOOST_STATIC_ASSERT(sizeof(U) > 0);
+      //If T is not an array type, U derives from T
+      //and T has no virtual destructor, then you have a problem
+      BOOST_STATIC_ASSERT(( !::boost::move_upmu::missing_virtual_destructor<default_delete<T>, U>::value ));
+      element_type * const p = static_cast<element_type*>(ptr);
+      if(p){
+         #if defined(BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL)
+         bmupd::thread_retire_buffer().push(bmupd::make_retired_ptr<T>(p));
+         #else
+         default_delete<T>()(p);
+         #endif
+      }
+   }
+
+   //! <b>Effects</b>: Same as <tt>(*this)(static_cast<element_type*>(nullptr))</tt>.
+   //!
+   void operator()(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) const BOOST_NOEXCEPT
+   {  BOOST_STATIC_ASSERT(sizeof(element_type) > 0);  }
+
+   //! <b>Effects</b>: Destroys all the objects retired by the calling thread,
+   //!   whatever their type, including those retired while flushing.
+   static void flush() BOOST_NOEXCEPT
+   {
+      #if defined(BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL)
+      bmupd::thread_retire_buffer().drain();
+      #endif
+   }
+
+   //! <b>Returns</b>: The number of objects retired by the calling thread that are still pending.
+   //!
+   static std::size_t pending() BOOST_NOEXCEPT
+   {
+      #if defined(BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL)
+      return bmupd::thread_retire_buffer().size;
+      #else
+      return 0u;
+      #endif
+   }
+};
+
+#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+//!A <tt>deferred_reclaimer</tt> owns a background thread that destroys the batches
+//!of objects retired through <tt>deferred_delete</tt> by any thread. While a reclaimer
+//!is alive, retiring threads hand off full buffers instead of draining them.
+//!
+//!Only one reclaimer can be alive at a time. Its destructor destroys all pending batches.
+//!Objects retired but still buffered by a thread are not affected: they are destroyed when
+//!that thread's buffer gets full again, is flushed or the thread exits.
+//!
+//!Only available if the compiler supports C++11 threads and <tt>thread_local</tt>.
+class deferred_reclaimer
+{
+   deferred_reclaimer(const deferred_reclaimer &);
+   deferred_reclaimer &operator=(const deferred_reclaimer &);
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   typedef bmupd::reclaimer_registry_t registry_t;
+   typedef bmupd::reclaimer_queue::batch_t batch_t;
+   #endif
+
+   public:
+   //! <b>Effects</b>: Starts the background thread and registers it as the reclaimer
+   //!   that receives full retire buffers.
+   //!
+   //! <b>Throws</b>: If the thread can't be started.
+   deferred_reclaimer()
+   {
+      m_queue.stop = false;
+      m_queue.thread = std::thread(&deferred_reclaimer::run, &m_queue);
+      std::lock_guard<std::mutex> lock(registry_t::mutex);
+      BOOST_ASSERT(!registry_t::current);
+      registry_t::current = &m_queue;
+   }
+
+   //! <b>Effects</b>: Unregisters the reclaimer, destroys the pending batches
+   //!   and joins the background thread.
+   ~deferred_reclaimer()
+   {
+      {
+         std::lock_guard<std::mutex> lock(registry_t::mutex);
+         registry_t::current = 0;
+         m_queue.stop = true;
+      }
+      m_queue.cond.notify_one();
+      m_queue.thread.join();
+   }
+
+   //! <b>Returns</b>: The number of batches handed off and not yet processed.
+   //!
+   std::size_t pending_batches() const
+   {
+      std::lock_guard<std::mutex> lock(registry_t::mutex);
+      return m_queue.batches.size();
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   static void run(bmupd::reclaimer_queue *q)
+   {
+      std::vector<batch_t> work;
+      for(;;){
+         {
+            std::unique_lock<std::mutex> lock(registry_t::mutex);
+            while(!q->stop && q->batches.empty()){
+               q->cond.wait(lock);
+            }
+            if(q->batches.empty()){
+               break;
+            }
+            work.swap(q->batches);
+         }
+         for(std::size_t i = 0, imax = work.size(); i != imax; ++i){
+            batch_t &b = work[i];
+            for(std::size_t j = b.size(); j; --j){
+               b[j-1].destroy(b[j-1].ptr);
+            }
+         }
+         work.clear();
+         //Objects retired by the destructors of the processed batches
+         bmupd::thread_retire_buffer().drain();
+      }
+      bmupd::thread_retire_buffer().drain();
+   }
+
+   bmupd::reclaimer_queue m_queue;
+   #endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+};
+
+#endif   //#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_DEFERRED_DELETE_HPP_INCLUDED
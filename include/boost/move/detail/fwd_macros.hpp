@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_DETAIL_FWD_MACROS_HPP
+#define BOOST_MOVE_DETAIL_FWD_MACROS_HPP
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+
+//Preprocessor helpers used by factories to emulate perfect
+//forwarding of a variable number of arguments in C++03 compilers
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+#include <boost/move/utility_core.hpp>
+#include <boost/preprocessor/iteration/local.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_params.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing.hpp>
+#include <boost/preprocessor/repetition/enum.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/preprocessor/control/if.hpp>
+#include <boost/preprocessor/facilities/empty.hpp>
+#include <boost/preprocessor/comparison/less_equal.hpp>
+#include <boost/preprocessor/seq/elem.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
+#include <boost/preprocessor/tuple/eat.hpp>
+
+   #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+      #define BOOST_MOVE_PP_PARAM_LIST(z, n, data) \
+      BOOST_PP_CAT(P, n) && BOOST_PP_CAT(p, n) \
+      //!
+   #else
+      #define BOOST_MOVE_PP_PARAM_LIST(z, n, data) \
+      const BOOST_PP_CAT(P, n) & BOOST_PP_CAT(p, n) \
+      //!
+   #endif   //#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+   #define BOOST_MOVE_PP_PARAM_FORWARD(z, n, data) \
+   ::boost::forward< BOOST_PP_CAT(P, n) >( BOOST_PP_CAT(p, n) ) \
+   //!
+
+   //Maximum number of arguments the C++03 factories accept. Can be raised by the user
+   //up to the iteration limit of Boost.Preprocessor at the cost of longer compilations.
+   #ifndef BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS
+      #define BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS 10
+   #endif
+
+   //////////////////////////////////////
+   //    Lvalue reference forwarding
+   //////////////////////////////////////
+
+   //Taking arguments as const P & copies non-const lvalues and can't bind them to
+   //constructors taking non-const references. Factories that use the _MASK macros
+   //are instead generated once for each combination of P & and const P & parameters,
+   //so that non-const lvalues and boost::move results (rv<T> &) are passed as-is and
+   //only real rvalues take the const P & parameter. As 2^n overloads are needed for n
+   //parameters, this is done only up to BOOST_MOVE_MAX_LVALUE_FORWARDING_PARAMETERS
+   //(at most 6), calls with more arguments take all of them by const reference.
+   #ifndef BOOST_MOVE_MAX_LVALUE_FORWARDING_PARAMETERS
+      #define BOOST_MOVE_MAX_LVALUE_FORWARDING_PARAMETERS 4
+   #endif
+
+   #define BOOST_MOVE_PP_POW2_0 1
+   #define BOOST_MOVE_PP_POW2_1 2
+   #define BOOST_MOVE_PP_POW2_2 4
+   #define BOOST_MOVE_PP_POW2_3 8
+   #define BOOST_MOVE_PP_POW2_4 16
+   #define BOOST_MOVE_PP_POW2_5 32
+   #define BOOST_MOVE_PP_POW2_6 64
+
+   #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+      //P && already forwards everything, one overload is enough
+      #define BOOST_MOVE_PP_MASK_COUNT(n) 1
+      #define BOOST_MOVE_PP_PARAM_LIST_MASK(z, n, mask) BOOST_MOVE_PP_PARAM_LIST(z, n, mask)
+      #define BOOST_MOVE_PP_PARAM_FORWARD_MASK(z, n, mask) BOOST_MOVE_PP_PARAM_FORWARD(z, n, mask)
+   #else
+      //Number of overloads needed for n parameters
+      #define BOOST_MOVE_PP_MASK_COUNT(n) \
+      BOOST_PP_IF( BOOST_PP_LESS_EQUAL(n, BOOST_MOVE_MAX_LVALUE_FORWARDING_PARAMETERS) \
+                 , BOOST_PP_CAT(BOOST_MOVE_PP_POW2_, n), 1) \
+      //!
+
+      //1 if the n-th parameter is taken by non-const reference in overload mask.
+      //Overloads with more parameters than the limit only have mask 0 and take
+      //const references, other overloads have less than 7 parameters. Bits are
+      //looked up in a table, BOOST_PP_DIV, BOOST_PP_MOD and BOOST_PP_LESS_EQUAL
+      //are too slow to preprocess for each parameter of each overload.
+      #define BOOST_MOVE_PP_MASK_BIT(mask, n) \
+      BOOST_PP_IF(mask, BOOST_MOVE_PP_MASK_BIT_I, 0 BOOST_PP_TUPLE_EAT(2))(mask, n) \
+      //!
+
+      #define BOOST_MOVE_PP_MASK_BIT_I(mask, n) \
+      BOOST_PP_SEQ_ELEM(mask, BOOST_PP_CAT(BOOST_MOVE_PP_MASK_BITS_, n)) \
+      //!
+
+      //BOOST_MOVE_PP_MASK_BITS_n: bit n of masks 0 to 63
+      #define BOOST_MOVE_PP_MASK_BITS_0 \
+         (0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1) \
+         (0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1)(0)(1) \
+      //!
+
+      #define BOOST_MOVE_PP_MASK_BITS_1 \
+         (0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1) \
+         (0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1)(0)(0)(1)(1) \
+      //!
+
+      #define BOOST_MOVE_PP_MASK_BITS_2 \
+         (0)(0)(0)(0)(1)(1)(1)(1)(0)(0)(0)(0)(1)(1)(1)(1)(0)(0)(0)(0)(1)(1)(1)(1)(0)(0)(0)(0)(1)(1)(1)(1) \
+         (0)(0)(0)(0)(1)(1)(1)(1)(0)(0)(0)(0)(1)(1)(1)(1)(0)(0)(0)(0)(1)(1)(1)(1)(0)(0)(0)(0)(1)(1)(1)(1) \
+      //!
+
+      #define BOOST_MOVE_PP_MASK_BITS_3 \
+         (0)(0)(0)(0)(0)(0)(0)(0)(1)(1)(1)(1)(1)(1)(1)(1)(0)(0)(0)(0)(0)(0)(0)(0)(1)(1)(1)(1)(1)(1)(1)(1) \
+         (0)(0)(0)(0)(0)(0)(0)(0)(1)(1)(1)(1)(1)(1)(1)(1)(0)(0)(0)(0)(0)(0)(0)(0)(1)(1)(1)(1)(1)(1)(1)(1) \
+      //!
+
+      #define BOOST_MOVE_PP_MASK_BITS_4 \
+         (0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1) \
+         (0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1) \
+      //!
+
+      #define BOOST_MOVE_PP_MASK_BITS_5 \
+         (0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0)(0) \
+         (1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1)(1) \
+      //!
+
+      #define BOOST_MOVE_PP_PARAM_LIST_MASK(z, n, mask) \
+      BOOST_PP_IF(BOOST_MOVE_PP_MASK_BIT(mask, n), BOOST_PP_EMPTY, const BOOST_PP_EMPTY)() \
+         BOOST_PP_CAT(P, n) & BOOST_PP_CAT(p, n) \
+      //!
+
+      //Lvalues are passed as they are, boost::forward detects rv<T> in const references
+      #define BOOST_MOVE_PP_PARAM_FORWARD_MASK(z, n, mask) \
+      BOOST_PP_IF( BOOST_MOVE_PP_MASK_BIT(mask, n) \
+                 , BOOST_PP_CAT(p, n) BOOST_PP_EMPTY \
+                 , BOOST_MOVE_PP_PARAM_FORWARD(z, n, mask) BOOST_PP_EMPTY)() \
+      //!
+   #endif   //#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+   //Expands MACRO(n, mask) once for each overload needed for n parameters.
+   //MACRO uses BOOST_MOVE_PP_PARAM_LIST_MASK and BOOST_MOVE_PP_PARAM_FORWARD_MASK
+   //passing mask as data argument.
+   #define BOOST_MOVE_PP_FOR_EACH_MASK(n, MACRO) \
+   BOOST_PP_REPEAT(BOOST_MOVE_PP_MASK_COUNT(n), BOOST_MOVE_PP_FOR_EACH_MASK_INVOKE, (n, MACRO)) \
+   //!
+
+   #define BOOST_MOVE_PP_FOR_EACH_MASK_INVOKE(z, mask, n_macro) \
+   BOOST_PP_TUPLE_ELEM(2, 1, n_macro)(BOOST_PP_TUPLE_ELEM(2, 0, n_macro), mask) \
+   //!
+
+#endif   //#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif //#ifndef BOOST_MOVE_DETAIL_FWD_MACROS_HPP
@@ -0,0 +1,217 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_DETAIL_MEMORY_UTILS_HPP
+#define BOOST_MOVE_DETAIL_MEMORY_UTILS_HPP
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>   //for std::size_t
+#include <cstdlib>   //for std::malloc, std::calloc, std::free
+#include <new>       //for operator new/delete, std::bad_alloc
+
+//Raw memory helpers used by the owners and factories that manage
+//storage themselves instead of using new/delete expressions
+
+namespace boost {
+namespace move_upd {
+
+//////////////////////////////////////
+//       array_allocation_size
+//////////////////////////////////////
+
+//Returns n*elem_size or throws std::bad_alloc on overflow
+inline std::size_t array_allocation_size(std::size_t n, std::size_t elem_size)
+{
+   if(elem_size && n > std::size_t(-1)/elem_size){
+      ::boost::throw_exception(std::bad_alloc());
+   }
+   return n*elem_size;
+}
+
+//////////////////////////////////////
+//          max_align_t
+//////////////////////////////////////
+
+//A type with the strictest alignment of the fundamental types.
+//Memory returned by operator new is suitably aligned for it.
+union max_align_t
+{
+   char c;
+   short s;
+   int i;
+   long l;
+   #if defined(BOOST_HAS_LONG_LONG)
+   ::boost::long_long_type ll;
+   #endif
+   float f;
+   double d;
+   long double ld;
+   void *p;
+   void (*fp)();
+};
+
+//////////////////////////////////////
+//          alignment_of
+//////////////////////////////////////
+template<class T>
+struct alignment_of_hack
+{
+   char c;
+   T t;
+   alignment_of_hack();
+};
+
+template<class T>
+struct alignment_of
+{
+   static const std::size_t value = sizeof(alignment_of_hack<T>) - sizeof(T);
+};
+
+//////////////////////////////////////
+//        max_aligned_storage
+//////////////////////////////////////
+
+//Raw storage of Size bytes aligned for any fundamental type
+template<std::size_t Size>
+union max_aligned_storage
+{
+   unsigned char data[Size];
+   max_align_t align;
+};
+
+//////////////////////////////////////
+//       raw_allocate
+//////////////////////////////////////
+inline void *raw_allocate(std::size_t bytes)
+{  return ::operator new(bytes);  }
+
+//////////////////////////////////////
+//       raw_deallocate
+//////////////////////////////////////
+
+//Deallocates memory obtained from raw_allocate(bytes),
+//passing the size to the deallocation function if available
+inline void raw_deallocate(void *p, std::size_t bytes) BOOST_NOEXCEPT
+{
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   ::operator delete(p, bytes);
+   #else
+   (void)bytes;
+   ::operator delete(p);
+   #endif
+}
+
+//////////////////////////////////////
+//       raw_array_allocate
+//////////////////////////////////////
+inline void *raw_array_allocate(std::size_t bytes)
+{  return ::operator new[](bytes);  }
+
+//////////////////////////////////////
+//       raw_array_deallocate
+//////////////////////////////////////
+
+//Deallocates memory obtained from raw_array_allocate(bytes),
+//passing the size to the deallocation function if available
+inline void raw_array_deallocate(void *p, std::size_t bytes) BOOST_NOEXCEPT
+{
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   ::operator delete[](p, bytes);
+   #else
+   (void)bytes;
+   ::operator delete[](p);
+   #endif
+}
+
+//////////////////////////////////////
+//       raw_c_allocate
+//////////////////////////////////////
+
+//Allocates bytes with std::malloc or throws std::bad_alloc.
+//If zeroed is true the storage is obtained with std::calloc so that
+//big blocks can be mapped from zero pages instead of being cleared
+inline void *raw_c_allocate(std::size_t bytes, bool zeroed)
+{
+   //Never request zero bytes, as a null result would be ambiguous
+   const std::size_t n = bytes ? bytes : 1u;
+   void *const p = zeroed ? std::calloc(n, 1u) : std::malloc(n);
+   if(!p){
+      ::boost::throw_exception(std::bad_alloc());
+   }
+   return p;
+}
+
+//////////////////////////////////////
+//       raw_c_deallocate
+//////////////////////////////////////
+
+//Deallocates memory obtained from raw_c_allocate
+inline void raw_c_deallocate(void *p) BOOST_NOEXCEPT
+{  std::free(p);  }
+
+//////////////////////////////////////
+//       raw_aligned_allocate
+//////////////////////////////////////
+
+//Allocates bytes aligned to align, which must be a power of two
+//not lower than the alignment of max_align_t
+inline void *raw_aligned_allocate(std::size_t bytes, std::size_t align)
+{
+   BOOST_ASSERT(align && !(align & (align - 1u)));
+   BOOST_ASSERT(align >= alignment_of<max_align_t>::value);
+   #if defined(BOOST_MOVE_HAS_ALIGNED_NEW)
+   return ::operator new(bytes, std::align_val_t(align));
+   #else
+   //Over-allocate and store the distance to the start of the block just
+   //before the aligned address. There is room for it as the block is
+   //aligned to max_align_t so the distance is at least that alignment.
+   if(bytes > std::size_t(-1) - align){
+      ::boost::throw_exception(std::bad_alloc());
+   }
+   char *const raw = static_cast<char*>(::operator new(bytes + align));
+   const std::size_t offset = align - (reinterpret_cast<std::size_t>(raw) & (align - 1u));
+   char *const p = raw + offset;
+   reinterpret_cast<std::size_t*>(p)[-1] = offset;
+   return p;
+   #endif
+}
+
+//////////////////////////////////////
+//       raw_aligned_deallocate
+//////////////////////////////////////
+
+//Deallocates memory obtained from raw_aligned_allocate(bytes, align)
+inline void raw_aligned_deallocate(void *p, std::size_t bytes, std::size_t align) BOOST_NOEXCEPT
+{
+   #if defined(BOOST_MOVE_HAS_ALIGNED_NEW)
+      #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+      ::operator delete(p, bytes, std::align_val_t(align));
+      #else
+      (void)bytes;
+      ::operator delete(p, std::align_val_t(align));
+      #endif
+   #else
+   const std::size_t offset = static_cast<std::size_t*>(p)[-1];
+   raw_deallocate(static_cast<char*>(p) - offset, bytes + align);
+   #endif
+}
+
+}  //namespace move_upd {
+}  //namespace boost {
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif //#ifndef BOOST_MOVE_DETAIL_MEMORY_UTILS_HPP
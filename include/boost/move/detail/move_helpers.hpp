@@ -14,6 +14,8 @@
 
 #include <boost/move/utility.hpp>
 #include <boost/move/detail/meta_utils.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/is_convertible.hpp>
 
 #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
 
@@ -61,6 +63,38 @@
    }\
 //
 
+//Like BOOST_MOVE_CONVERSION_AWARE_CATCH, but arguments convertible to TYPE are passed
+//unchanged to EMPLACE_FUNCTION so that the element is constructed in place instead
+//of constructing a temporary TYPE and moving it through FWD_FUNCTION.
+#define BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, EMPLACE_FUNCTION)\
+   RETURN_VALUE PUB_FUNCTION(BOOST_MOVE_CATCH_CONST(TYPE) x)\
+   {  return FWD_FUNCTION(static_cast<const TYPE&>(x)); }\
+\
+   RETURN_VALUE PUB_FUNCTION(BOOST_MOVE_CATCH_RVALUE(TYPE) x) \
+   {  return FWD_FUNCTION(::boost::move(x));  }\
+\
+   RETURN_VALUE PUB_FUNCTION(TYPE &x)\
+   {  return FWD_FUNCTION(const_cast<const TYPE &>(x)); }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c\
+                     <  ::boost::move_detail::is_class_or_union<TYPE>::value &&\
+                        ::boost::move_detail::is_same<TYPE, BOOST_MOVE_TEMPL_PARAM>::value &&\
+                       !::boost::has_move_emulation_enabled<BOOST_MOVE_TEMPL_PARAM>::value\
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(const BOOST_MOVE_TEMPL_PARAM &u)\
+   { return FWD_FUNCTION(u); }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c\
+                     < (!::boost::move_detail::is_class_or_union<BOOST_MOVE_TEMPL_PARAM>::value || \
+                        !::boost::move_detail::is_rv<BOOST_MOVE_TEMPL_PARAM>::value) && \
+                        !::boost::move_detail::is_same<TYPE, BOOST_MOVE_TEMPL_PARAM>::value \
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(const BOOST_MOVE_TEMPL_PARAM &u)\
+   {  return EMPLACE_FUNCTION(u);  }\
+//
+
 #elif (defined(_MSC_VER) && (_MSC_VER == 1600))
 
 #define BOOST_MOVE_CONVERSION_AWARE_CATCH(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION)\
@@ -81,6 +115,21 @@
    }\
 //
 
+#define BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, EMPLACE_FUNCTION)\
+   RETURN_VALUE PUB_FUNCTION(BOOST_MOVE_CATCH_CONST(TYPE) x)\
+   {  return FWD_FUNCTION(static_cast<const TYPE&>(x)); }\
+\
+   RETURN_VALUE PUB_FUNCTION(BOOST_MOVE_CATCH_RVALUE(TYPE) x) \
+   {  return FWD_FUNCTION(::boost::move(x));  }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c\
+                     < !::boost::move_detail::is_same<TYPE, BOOST_MOVE_TEMPL_PARAM>::value\
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(const BOOST_MOVE_TEMPL_PARAM &u)\
+   {  return EMPLACE_FUNCTION(u);  }\
+//
+
 #else
 
 #define BOOST_MOVE_CONVERSION_AWARE_CATCH(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION)\
@@ -91,6 +140,22 @@
    {  return FWD_FUNCTION(::boost::move(x));  }\
 //
 
+#define BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, EMPLACE_FUNCTION)\
+   RETURN_VALUE PUB_FUNCTION(BOOST_MOVE_CATCH_CONST(TYPE) x)\
+   {  return FWD_FUNCTION(static_cast<const TYPE&>(x)); }\
+\
+   RETURN_VALUE PUB_FUNCTION(BOOST_MOVE_CATCH_RVALUE(TYPE) x) \
+   {  return FWD_FUNCTION(::boost::move(x));  }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c\
+                     < !::boost::move_detail::is_same<TYPE, typename ::boost::remove_cv<typename ::boost::move_detail::remove_reference<BOOST_MOVE_TEMPL_PARAM>::type>::type>::value && \
+                        ::boost::is_convertible<BOOST_MOVE_TEMPL_PARAM, TYPE>::value \
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(BOOST_MOVE_TEMPL_PARAM &&u)\
+   {  return EMPLACE_FUNCTION(::boost::forward<BOOST_MOVE_TEMPL_PARAM>(u));  }\
+//
+
 #endif
 
 
@@ -127,6 +192,34 @@
    }\
 //
 
+#define BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE_1ARG(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, EMPLACE_FUNCTION, ARG1, UNLESS_CONVERTIBLE_TO)\
+   RETURN_VALUE PUB_FUNCTION(ARG1 arg1, BOOST_MOVE_CATCH_CONST(TYPE) x)\
+   {  return FWD_FUNCTION(arg1, static_cast<const TYPE&>(x)); }\
+\
+   RETURN_VALUE PUB_FUNCTION(ARG1 arg1, BOOST_MOVE_CATCH_RVALUE(TYPE) x) \
+   {  return FWD_FUNCTION(arg1, ::boost::move(x));  }\
+\
+   RETURN_VALUE PUB_FUNCTION(ARG1 arg1, TYPE &x)\
+   {  return FWD_FUNCTION(arg1, const_cast<const TYPE &>(x)); }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c<\
+                        ::boost::move_detail::is_same<TYPE, BOOST_MOVE_TEMPL_PARAM>::value &&\
+                       !::boost::has_move_emulation_enabled<BOOST_MOVE_TEMPL_PARAM>::value\
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(ARG1 arg1, const BOOST_MOVE_TEMPL_PARAM &u)\
+   { return FWD_FUNCTION(arg1, u); }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c<\
+                       !::boost::move_detail::is_rv<BOOST_MOVE_TEMPL_PARAM>::value && \
+                       !::boost::move_detail::is_same<TYPE, BOOST_MOVE_TEMPL_PARAM>::value && \
+                       !::boost::move_detail::is_convertible<BOOST_MOVE_TEMPL_PARAM, UNLESS_CONVERTIBLE_TO>::value \
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(ARG1 arg1, const BOOST_MOVE_TEMPL_PARAM &u)\
+   {  return EMPLACE_FUNCTION(arg1, u);  }\
+//
+
 #elif (defined(_MSC_VER) && (_MSC_VER == 1600))
 
 #define BOOST_MOVE_CONVERSION_AWARE_CATCH_1ARG(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, ARG1, UNLESS_CONVERTIBLE_TO)\
@@ -148,6 +241,22 @@
    }\
 //
 
+#define BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE_1ARG(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, EMPLACE_FUNCTION, ARG1, UNLESS_CONVERTIBLE_TO)\
+   RETURN_VALUE PUB_FUNCTION(ARG1 arg1, BOOST_MOVE_CATCH_CONST(TYPE) x)\
+   {  return FWD_FUNCTION(arg1, static_cast<const TYPE&>(x)); }\
+\
+   RETURN_VALUE PUB_FUNCTION(ARG1 arg1, BOOST_MOVE_CATCH_RVALUE(TYPE) x) \
+   {  return FWD_FUNCTION(arg1, ::boost::move(x));  }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c\
+                     < !::boost::move_detail::is_same<TYPE, BOOST_MOVE_TEMPL_PARAM>::value && \
+                       !::boost::move_detail::is_convertible<BOOST_MOVE_TEMPL_PARAM, UNLESS_CONVERTIBLE_TO>::value \
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(ARG1 arg1, const BOOST_MOVE_TEMPL_PARAM &u)\
+   {  return EMPLACE_FUNCTION(arg1, u);  }\
+//
+
 #else
 
 #define BOOST_MOVE_CONVERSION_AWARE_CATCH_1ARG(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, ARG1, UNLESS_CONVERTIBLE_TO)\
@@ -158,6 +267,23 @@
    {  return FWD_FUNCTION(arg1, ::boost::move(x));  }\
 //
 
+#define BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE_1ARG(PUB_FUNCTION, TYPE, RETURN_VALUE, FWD_FUNCTION, EMPLACE_FUNCTION, ARG1, UNLESS_CONVERTIBLE_TO)\
+   RETURN_VALUE PUB_FUNCTION(ARG1 arg1, BOOST_MOVE_CATCH_CONST(TYPE) x)\
+   {  return FWD_FUNCTION(arg1, static_cast<const TYPE&>(x)); }\
+\
+   RETURN_VALUE PUB_FUNCTION(ARG1 arg1, BOOST_MOVE_CATCH_RVALUE(TYPE) x) \
+   {  return FWD_FUNCTION(arg1, ::boost::move(x));  }\
+\
+   template<class BOOST_MOVE_TEMPL_PARAM>\
+   typename ::boost::move_detail::enable_if_c\
+                     < !::boost::move_detail::is_same<TYPE, typename ::boost::remove_cv<typename ::boost::move_detail::remove_reference<BOOST_MOVE_TEMPL_PARAM>::type>::type>::value && \
+                        ::boost::is_convertible<BOOST_MOVE_TEMPL_PARAM, TYPE>::value && \
+                       !::boost::is_convertible<BOOST_MOVE_TEMPL_PARAM, UNLESS_CONVERTIBLE_TO>::value \
+                     , RETURN_VALUE >::type\
+   PUB_FUNCTION(ARG1 arg1, BOOST_MOVE_TEMPL_PARAM &&u)\
+   {  return EMPLACE_FUNCTION(arg1, ::boost::forward<BOOST_MOVE_TEMPL_PARAM>(u));  }\
+//
+
 #endif
 
 #endif //#ifndef BOOST_MOVE_MOVE_HELPERS_HPP
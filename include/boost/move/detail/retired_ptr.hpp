@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_DETAIL_RETIRED_PTR_HPP
+#define BOOST_MOVE_DETAIL_RETIRED_PTR_HPP
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/default_delete.hpp>
+
+//Type-erased pointers whose destruction has been postponed by the
+//deleters that don't destroy objects inline
+
+namespace boost {
+namespace move_upd {
+
+//////////////////////////////////////
+//           retired_ptr
+//////////////////////////////////////
+struct retired_ptr
+{
+   void *ptr;
+   void (*destroy)(void *);
+};
+
+//Destroys the object or array as default_delete<T> would do
+template<class T>
+struct deferred_destroy
+{
+   typedef typename bmupmu::remove_extent<T>::type element_type;
+
+   static void call(void *p) BOOST_NOEXCEPT
+   {  ::boost::movelib::default_delete<T>()(static_cast<element_type*>(p));  }
+};
+
+template<class T>
+inline retired_ptr make_retired_ptr(typename bmupmu::remove_extent<T>::type *p) BOOST_NOEXCEPT
+{
+   retired_ptr r;
+   r.ptr = const_cast<void*>(static_cast<const volatile void*>(p));
+   r.destroy = &deferred_destroy<T>::call;
+   return r;
+}
+
+}  //namespace move_upd {
+}  //namespace boost {
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif //#ifndef BOOST_MOVE_DETAIL_RETIRED_PTR_HPP
@@ -399,6 +399,13 @@ struct pointer_type
       <typename remove_extent<T>::type, typename remove_reference<D>::type>::type type;
 };
 
+//default_delete has no pointer typedef, avoid detecting it
+template <class T, class U>
+struct pointer_type<T, ::boost::movelib::default_delete<U> >
+{
+    typedef typename remove_extent<T>::type* type;
+};
+
 //////////////////////////////////////
 //           is_convertible
 //////////////////////////////////////
@@ -551,6 +558,28 @@ struct is_unary_function
    struct has_virtual_destructor{   static const bool value = true;  };
 #endif
 
+//////////////////////////////////////
+//             is_final
+//////////////////////////////////////
+#if (defined(BOOST_MSVC) && (BOOST_MSVC >= 1700))
+#  define BOOST_MOVEUP_IS_FINAL(T) __is_sealed(T)
+#elif defined(BOOST_CLANG) && defined(__has_feature)
+#  if __has_feature(is_final)
+#     define BOOST_MOVEUP_IS_FINAL(T) __is_final(T)
+#  endif
+#elif defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7))) && !defined(BOOST_CLANG)
+#  define BOOST_MOVEUP_IS_FINAL(T) __is_final(T)
+#endif
+
+#ifdef BOOST_MOVEUP_IS_FINAL
+   template<class T>
+   struct is_final{   static const bool value = BOOST_MOVEUP_IS_FINAL(T);  };
+#else
+   //If no intrinsic is available conservatively treat all classes as non-final
+   template<class T>
+   struct is_final{   static const bool value = false;  };
+#endif
+
 //////////////////////////////////////
 //       missing_virtual_destructor
 //////////////////////////////////////
@@ -577,6 +606,11 @@ struct missing_virtual_destructor< ::boost::movelib::default_delete<T>, U >
    : missing_virtual_destructor_default_delete<T, U>
 {};
 
+//Deleting through the same type is always fine
+template<class T>
+struct missing_virtual_destructor< ::boost::movelib::default_delete<T>, T >
+{  static const bool value = false;  };
+
 }  //namespace move_upmu {
 }  //namespace boost {
 
@@ -17,6 +17,31 @@
    #define BOOST_MOVE_PERFECT_FORWARDING
 #endif
 
+//C++14 sized deallocation functions (operator delete(void*, std::size_t))
+#if !defined(BOOST_MOVE_NO_SIZED_DEALLOCATION) && \
+    (  (defined(__cpp_sized_deallocation) && (__cpp_sized_deallocation >= 201309L)) || \
+       (defined(_MSC_VER) && (_MSC_VER >= 1900)) )
+   #define BOOST_MOVE_HAS_SIZED_DEALLOCATION
+#endif
+
+//C++17 aligned allocation functions (operator new(std::size_t, std::align_val_t))
+#if !defined(BOOST_MOVE_NO_ALIGNED_NEW) && \
+    defined(__cpp_aligned_new) && (__cpp_aligned_new >= 201606L)
+   #define BOOST_MOVE_HAS_ALIGNED_NEW
+#endif
+
+//C++17 template<auto N> non-type template parameters
+#if defined(__cpp_nontype_template_parameter_auto) && (__cpp_nontype_template_parameter_auto >= 201606L)
+   #define BOOST_MOVE_HAS_AUTO_NONTYPE_TEMPLATE_PARAMETERS
+#endif
+
+//Returns P, telling the optimizer that it's aligned to N bytes
+#if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+   #define BOOST_MOVE_ASSUME_ALIGNED(P, N) __builtin_assume_aligned((P), (N))
+#else
+   #define BOOST_MOVE_ASSUME_ALIGNED(P, N) (P)
+#endif
+
 //Macros for documentation purposes. For code, expands to the argument
 #define BOOST_MOVE_IMPDEF(TYPE) TYPE
 #define BOOST_MOVE_SEEDOC(TYPE) TYPE
@@ -0,0 +1,429 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_EPOCH_DELETE_HPP_INCLUDED
+#define BOOST_MOVE_EPOCH_DELETE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/default_delete.hpp>
+#include <boost/move/detail/retired_ptr.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+
+#if  !defined(BOOST_NO_CXX11_THREAD_LOCAL)      && \
+     !defined(BOOST_NO_CXX11_HDR_ATOMIC)        && \
+     !defined(BOOST_NO_CXX11_HDR_THREAD)        && \
+     !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   #define BOOST_MOVE_HAS_EPOCH_DELETE
+#endif
+
+#if defined(BOOST_MOVE_HAS_EPOCH_DELETE)
+   #include <atomic>
+   #include <thread>
+   #include <vector>
+   #include <cstddef>   //For std::size_t
+#endif
+
+//!\file
+//! Describes <tt>epoch_delete</tt>, a deleter for <tt>unique_ptr</tt> that implements
+//! epoch-based reclamation, <tt>epoch_guard</tt>, which marks read-side critical sections,
+//! and <tt>epoch_slot</tt>, an atomic owning pointer that readers can load without locks.
+//!
+//! Only available if the compiler supports C++11 atomics, threads and <tt>thread_local</tt>.
+
+//! Number of retirements after which a thread tries to advance the global epoch.
+#ifndef BOOST_MOVE_EPOCH_DELETE_RECLAIM_THRESHOLD
+   #define BOOST_MOVE_EPOCH_DELETE_RECLAIM_THRESHOLD 64
+#endif
+
+#if defined(BOOST_MOVE_HAS_EPOCH_DELETE) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace move_upd {
+
+//////////////////////////////////////
+//           epoch_record
+//////////////////////////////////////
+
+//Per-thread state. Records are never freed: when a thread exits its record
+//(and the objects it could not reclaim yet) is adopted by the next new thread.
+struct epoch_record
+{
+   //Objects retired in the same epoch
+   struct limbo_list
+   {
+      std::size_t epoch;
+      std::vector<retired_ptr> objects;
+   };
+
+   //(epoch << 1) | 1 while the thread is inside an epoch_guard, 0 otherwise
+   std::atomic<std::size_t> local;
+   std::atomic<bool> in_use;
+   epoch_record *next;
+   std::size_t nesting;
+   std::size_t retired_since_advance;
+   limbo_list limbo[3];
+
+   epoch_record()
+      : local(0), in_use(true), next(0), nesting(0), retired_since_advance(0)
+   {
+      for(std::size_t i = 0; i != 3; ++i){
+         limbo[i].epoch = 0;
+      }
+   }
+
+   std::size_t pending() const
+   {  return limbo[0].objects.size() + limbo[1].objects.size() + limbo[2].objects.size();  }
+
+   //Destroys the objects retired two or more epochs before global_epoch.
+   void reclaim(std::size_t global_epoch)
+   {
+      for(std::size_t i = 0; i != 3; ++i){
+         limbo_list &l = limbo[i];
+         if(!l.objects.empty() && l.epoch + 2 <= global_epoch){
+            //Destructors might retire more objects, so detach the list first
+            std::vector<retired_ptr> objects;
+            objects.swap(l.objects);
+            for(std::size_t j = 0, jmax = objects.size(); j != jmax; ++j){
+               objects[j].destroy(objects[j].ptr);
+            }
+            //Keep the capacity if no nested retirement went to this list
+            if(l.objects.empty()){
+               objects.clear();
+               l.objects.swap(objects);
+            }
+         }
+      }
+   }
+
+   void retire(const retired_ptr &r, std::size_t global_epoch)
+   {
+      this->reclaim(global_epoch);
+      limbo_list &l = limbo[global_epoch % 3];
+      //After reclaim() the list is either empty or holds objects of this epoch
+      l.epoch = global_epoch;
+      l.objects.push_back(r);
+   }
+};
+
+//////////////////////////////////////
+//          epoch_registry
+//////////////////////////////////////
+template<class Dummy>
+struct epoch_registry
+{
+   static std::atomic<std::size_t> global_epoch;
+   static std::atomic<epoch_record*> head;
+
+   static epoch_record *acquire()
+   {
+      //Reuse the record of an exited thread
+      for(epoch_record *r = head.load(std::memory_order_acquire); r; r = r->next){
+         bool expected = false;
+         if(!r->in_use.load(std::memory_order_relaxed) &&
+            r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)){
+            return r;
+         }
+      }
+      epoch_record *const r = new epoch_record;
+      epoch_record *old_head = head.load(std::memory_order_relaxed);
+      do{
+         r->next = old_head;
+      } while(!head.compare_exchange_weak(old_head, r, std::memory_order_release, std::memory_order_relaxed));
+      return r;
+   }
+
+   static void release(epoch_record *r)
+   {
+      r->local.store(0, std::memory_order_release);
+      r->in_use.store(false, std::memory_order_release);
+   }
+
+   //Advances the global epoch if every thread inside a critical section
+   //has observed the current one. Returns the global epoch.
+   static std::size_t try_advance()
+   {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::size_t e = global_epoch.load(std::memory_order_acquire);
+      for(epoch_record *r = head.load(std::memory_order_acquire); r; r = r->next){
+         std::size_t const l = r->local.load(std::memory_order_acquire);
+         if((l & 1u) && (l >> 1) != e){
+            return e;
+         }
+      }
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if(global_epoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel)){
+         ++e;
+      }
+      return e;
+   }
+};
+
+template<class Dummy>
+std::atomic<std::size_t> epoch_registry<Dummy>::global_epoch(0);
+
+template<class Dummy>
+std::atomic<epoch_record*> epoch_registry<Dummy>::head(0);
+
+typedef epoch_registry<void> epoch_registry_t;
+
+//Acquires a record on first use and releases it on thread exit,
+//trying to reclaim the pending objects without blocking
+struct epoch_thread_handle
+{
+   epoch_record *rec;
+
+   epoch_thread_handle()
+      : rec(epoch_registry_t::acquire())
+   {}
+
+   ~epoch_thread_handle()
+   {
+      if(rec->nesting == 0){
+         rec->reclaim(epoch_registry_t::try_advance());
+         rec->reclaim(epoch_registry_t::try_advance());
+      }
+      epoch_registry_t::release(rec);
+   }
+};
+
+inline epoch_record &this_thread_epoch_record()
+{
+   static thread_local epoch_thread_handle handle;
+   return *handle.rec;
+}
+
+inline void epoch_retire(const retired_ptr &r)
+{
+   epoch_record &rec = this_thread_epoch_record();
+   std::size_t e = epoch_registry_t::global_epoch.load(std::memory_order_acquire);
+   if(++rec.retired_since_advance >= BOOST_MOVE_EPOCH_DELETE_RECLAIM_THRESHOLD){
+      rec.retired_since_advance = 0;
+      e = epoch_registry_t::try_advance();
+   }
+   rec.retire(r, e);
+}
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!An <tt>epoch_guard</tt> marks a read-side critical section. Objects retired through
+//!<tt>epoch_delete</tt> are not destroyed while a guard that was constructed before the
+//!retirement is alive, so pointers loaded inside the critical section remain valid
+//!until the guard is destroyed.
+//!
+//!Guards are cheap (two atomic stores and a fence) and can be nested.
+class epoch_guard
+{
+   epoch_guard(const epoch_guard &);
+   epoch_guard &operator=(const epoch_guard &);
+
+   public:
+   //! <b>Effects</b>: Enters a critical section in the current global epoch.
+   //!
+   epoch_guard()
+      : m_rec(bmupd::this_thread_epoch_record())
+   {
+      if(m_rec.nesting++ == 0){
+         std::size_t const e = bmupd::epoch_registry_t::global_epoch.load(std::memory_order_relaxed);
+         m_rec.local.store((e << 1) | 1u, std::memory_order_relaxed);
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+   }
+
+   //! <b>Effects</b>: Leaves the critical section.
+   //!
+   ~epoch_guard()
+   {
+      if(--m_rec.nesting == 0){
+         m_rec.local.store(0, std::memory_order_release);
+      }
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   bmupd::epoch_record &m_rec;
+   #endif
+};
+
+//!The class template <tt>epoch_delete</tt> is a deleter for <tt>unique_ptr</tt> that
+//!implements epoch-based reclamation. The object is not destroyed inline: it is
+//!retired in the current global epoch and destroyed by <tt>default_delete<T></tt>
+//!once the global epoch has advanced twice, that is, once every thread that was
+//!inside an <tt>epoch_guard</tt> at retirement time has left it.
+//!
+//!Retired objects are kept by the retiring thread, which tries to advance the global epoch
+//!every BOOST_MOVE_EPOCH_DELETE_RECLAIM_THRESHOLD retirements. Objects a thread could not
+//!destroy when exiting are adopted by the next thread that starts using epochs.
+//!Objects still pending at program exit are not destroyed.
+//!
+//! \tparam T The type to be deleted. It may be an incomplete type
+template <class T>
+struct epoch_delete
+{
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   typedef typename bmupmu::remove_extent<T>::type element_type;
+   #endif
+
+   //! Default constructor.
+   //!
+   epoch_delete() BOOST_NOEXCEPT
+   {}
+
+   //! <b>Effects</b>: Constructs an epoch_delete object from another <tt>epoch_delete<U></tt> object.
+   //!
+   //! <b>Remarks</b>: This constructor shall not participate in overload resolution unless:
+   //!   - If T is not an array type and U* is implicitly convertible to T*.
+   //!   - If T is an array type and U* is a more CV qualified pointer to remove_extent<T>::type.
+   template <class U>
+   epoch_delete(const epoch_delete<U>&
+      BOOST_MOVE_DOCIGN(BOOST_MOVE_I typename bmupd::enable_def_del<U BOOST_MOVE_I T>::type* =0)
+      ) BOOST_NOEXCEPT
+   {
+      //If T is not an array type, U derives from T
+      //and T has no virtual destructor, then you have a problem
+      BOOST_STATIC_ASSERT(( !::boost::move_upmu::missing_virtual_destructor<default_delete<T>, U>::value ));
+   }
+
+   //! <b>Effects</b>: If ptr is not null, retires static_cast<element_type*>(ptr) in the current epoch.
+   //!
+   //! <b>Throws</b>: std::bad_alloc if the retired object can't be recorded.
+   //!
+   //! <b>Remarks</b>: If U is an incomplete type, the program is ill-formed.
+   //!   This operator shall not participate in overload resolution unless:
+   //!      - T is not an array type and U* is convertible to T*, OR
+   //!      - T is an array type, and remove_cv<U>::type is the same type as
+   //!         remove_cv<remove_extent<T>::type>::type and U* is convertible to remove_extent<T>::type*.
+   template <class U>
+   BOOST_MOVE_DOC1ST(void, typename bmupd::enable_defdel_call<U BOOST_MOVE_I T BOOST_MOVE_I void>::type)
+      operator()(U* ptr) const
+   {
+      //U must be a complete type
+      BOOST_STATIC_ASSERT(sizeof(U) > 0);
+      //If T is not an array type, U derives from T
+      //and T has no virtual destructor, then you have a problem
+      BOOST_STATIC_ASSERT(( !::boost::move_upmu::missing_virtual_destructor<default_delete<T>, U>::value ));
+      element_type * const p = static_cast<element_type*>(ptr);
+      if(p){
+         bmupd::epoch_retire(bmupd::make_retired_ptr<T>(p));
+      }
+   }
+
+   //! <b>Effects</b>: Same as <tt>(*this)(static_cast<element_type*>(nullptr))</tt>.
+   //!
+   void operator()(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) const BOOST_NOEXCEPT
+   {  BOOST_STATIC_ASSERT(sizeof(element_type) > 0);  }
+
+   //! <b>Effects</b>: Tries to advance the global epoch and destroys the objects
+   //!   retired by the calling thread that are safe to destroy. Does not block.
+   static void reclaim()
+   {
+      bmupd::epoch_record &rec = bmupd::this_thread_epoch_record();
+      rec.reclaim(bmupd::epoch_registry_t::try_advance());
+   }
+
+   //! <b>Requires</b>: The calling thread is not inside an <tt>epoch_guard</tt>.
+   //!
+   //! <b>Effects</b>: Waits until all the objects retired by the calling thread,
+   //!   whatever their type, can be destroyed and destroys them.
+   static void flush()
+   {
+      bmupd::epoch_record &rec = bmupd::this_thread_epoch_record();
+      BOOST_ASSERT(rec.nesting == 0);
+      while(rec.pending()){
+         std::size_t const e = bmupd::epoch_registry_t::global_epoch.load(std::memory_order_acquire);
+         std::size_t const n = bmupd::epoch_registry_t::try_advance();
+         rec.reclaim(n);
+         if(n == e && rec.pending()){
+            std::this_thread::yield();
+         }
+      }
+   }
+
+   //! <b>Returns</b>: The number of objects retired by the calling thread not yet destroyed.
+   //!
+   static std::size_t pending()
+   {  return bmupd::this_thread_epoch_record().pending();  }
+};
+
+//!An <tt>epoch_slot</tt> holds an object owned through <tt>unique_ptr<T, epoch_delete<T> ></tt>
+//!that can be replaced by writers while readers access it without locks:
+//!readers call <tt>load()</tt> inside an <tt>epoch_guard</tt> and writers call
+//!<tt>exchange()</tt> or <tt>store()</tt>. The replaced object is retired, so it is not
+//!destroyed until every reader that could have loaded it has left its critical section.
+//!
+//!Writers must be serialized externally if they need to observe the replaced object.
+template <class T>
+class epoch_slot
+{
+   epoch_slot(const epoch_slot &);
+   epoch_slot &operator=(const epoch_slot &);
+
+   public:
+   typedef T element_type;
+   typedef ::boost::movelib::unique_ptr<T, epoch_delete<T> > unique_ptr_type;
+
+   //! <b>Effects</b>: Constructs an empty slot.
+   //!
+   epoch_slot() BOOST_NOEXCEPT
+      : m_ptr(0)
+   {}
+
+   //! <b>Effects</b>: Constructs a slot that takes ownership of the object owned by p.
+   //!
+   explicit epoch_slot(unique_ptr_type p) BOOST_NOEXCEPT
+      : m_ptr(p.release())
+   {}
+
+   //! <b>Effects</b>: Retires the owned object, if any.
+   //!
+   ~epoch_slot()
+   {  epoch_delete<T>()(m_ptr.load(std::memory_order_relaxed));  }
+
+   //! <b>Requires</b>: The calling thread is inside an <tt>epoch_guard</tt> if other threads can replace the object.
+   //!
+   //! <b>Returns</b>: The owned object. It remains valid until the guard is destroyed.
+   T *load() const BOOST_NOEXCEPT
+   {  return m_ptr.load(std::memory_order_acquire);  }
+
+   //! <b>Effects</b>: Replaces the owned object with the one owned by p.
+   //!
+   //! <b>Returns</b>: The previously owned object. Destroying it retires it.
+   unique_ptr_type exchange(unique_ptr_type p) BOOST_NOEXCEPT
+   {  return unique_ptr_type(m_ptr.exchange(p.release(), std::memory_order_acq_rel));  }
+
+   //! <b>Effects</b>: Replaces the owned object with the one owned by p and retires the previous one.
+   //!
+   void store(unique_ptr_type p)
+   {  this->exchange(::boost::move(p));  }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   std::atomic<T*> m_ptr;
+   #endif
+};
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#endif   //#if defined(BOOST_MOVE_HAS_EPOCH_DELETE) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_EPOCH_DELETE_HPP_INCLUDED
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_FN_DELETER_HPP_INCLUDED
+#define BOOST_MOVE_FN_DELETER_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+
+//!\file
+//! Describes <tt>fn_deleter</tt> and, in C++17 compilers, <tt>function_deleter</tt>: empty deleters that
+//! call a function fixed at compile time, so that owners using them don't store a function pointer.
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>fn_deleter</tt> is an empty deleter that calls the function Fn.
+//!
+//!Passing a function pointer such as <tt>&std::fclose</tt> as the deleter of a <tt>unique_ptr</tt>
+//!stores it in every owner, doubling its size. As the function is part of the type of
+//!<tt>fn_deleter<int(*)(std::FILE*), &std::fclose></tt>, the empty base optimization applies and
+//!<tt>unique_ptr<std::FILE, fn_deleter<int(*)(std::FILE*), &std::fclose> ></tt> has the size of a pointer.
+//!
+//!It can also be used with other owners, like <tt>unique_resource</tt>.
+//!
+//! \tparam F The type of the function pointer.
+//! \tparam Fn The function called to release the resource. Its result, if any, is discarded.
+template<class F, F Fn>
+struct fn_deleter
+{
+   //! <b>Effects</b>: <tt>Fn(p)</tt>.
+   //!
+   template<class P>
+   void operator()(P p) const
+   {  Fn(p);  }
+};
+
+#if defined(BOOST_MOVE_DOXYGEN_INVOKED) || defined(BOOST_MOVE_HAS_AUTO_NONTYPE_TEMPLATE_PARAMETERS)
+
+//!The class template <tt>function_deleter</tt> is the C++17 form of <tt>fn_deleter</tt>, that deduces the
+//!type of the function: <tt>unique_ptr<std::FILE, function_deleter<&std::fclose> ></tt>.
+//!
+//! \tparam Fn The function called to release the resource. Its result, if any, is discarded.
+template<auto Fn>
+struct function_deleter
+   : fn_deleter<decltype(Fn), Fn>
+{};
+
+#endif
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_FN_DELETER_HPP_INCLUDED
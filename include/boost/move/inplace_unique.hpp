@@ -0,0 +1,344 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_INPLACE_UNIQUE_HPP_INCLUDED
+#define BOOST_MOVE_INPLACE_UNIQUE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/detail/memory_utils.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/move/detail/unique_ptr_meta_utils.hpp>
+#include <boost/move/default_delete.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>   //For std::size_t
+#include <new>       //For placement new
+
+//!\file
+//! Describes <tt>inplace_unique</tt>, a move-only owner of polymorphic objects that
+//! stores small objects inline instead of allocating them.
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace move_upd {
+
+//////////////////////////////////////
+//          inplace_vtable
+//////////////////////////////////////
+
+//Operations on an object of the dynamic type stored in the inline buffer
+template<class Base>
+struct inplace_vtable
+{
+   //Move constructs the object at src in dst, destroys
+   //the source object and returns the new object
+   Base *(*relocate)(void *dst, void *src);
+   void (*destroy)(void *p);
+};
+
+template<class Base, class D>
+struct inplace_ops
+{
+   static Base *relocate(void *dst, void *src)
+   {
+      D *const s = static_cast<D*>(src);
+      D *const d = ::new(dst) D(::boost::move(*s));
+      s->~D();
+      return d;
+   }
+
+   static void destroy(void *p)
+   {  static_cast<D*>(p)->~D();  }
+
+   static const inplace_vtable<Base> vtable;
+};
+
+template<class Base, class D>
+const inplace_vtable<Base> inplace_ops<Base, D>::vtable = { &inplace_ops::relocate, &inplace_ops::destroy };
+
+template<class D, std::size_t Size, std::size_t Align>
+struct inplace_fits
+{
+   static const bool value = sizeof(D) <= Size && (Align % alignment_of<D>::value) == 0;
+};
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>inplace_unique</tt> owns an object whose type is Base or
+//!derived from Base, with the move-only semantics of <tt>unique_ptr<Base></tt>.
+//!
+//!Objects whose size is at most Size bytes and whose alignment divides Align are stored
+//!in a buffer inside the <tt>inplace_unique</tt>, avoiding the allocation and the pointer
+//!chase. Bigger objects are allocated with <tt>new</tt>. Moving an <tt>inplace_unique</tt>
+//!relocates an inline object (move constructs it in the destination and destroys the source)
+//!and transfers the pointer of a heap-allocated object.
+//!
+//!The move constructor of the types stored inline shall not throw. If Base has no
+//!virtual destructor only objects of type Base can be stored.
+//!
+//! \tparam Base The static type of the owned objects.
+//! \tparam Size The size of the inline buffer.
+//! \tparam Align The alignment of the inline buffer. Can't be greater than the alignment
+//!   of the fundamental types.
+template< class Base
+        , std::size_t Size  BOOST_MOVE_DOCIGN(= 64u)
+        , std::size_t Align BOOST_MOVE_DOCIGN(= ::boost::move_upd::alignment_of< ::boost::move_upd::max_align_t>::value)>
+class inplace_unique
+{
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   public:
+   inplace_unique(const inplace_unique&) = delete;
+   inplace_unique& operator=(const inplace_unique&) = delete;
+   private:
+   #else
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(inplace_unique)
+   BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(inplace_unique)
+
+   BOOST_STATIC_ASSERT(( Size > 0u ));
+   BOOST_STATIC_ASSERT(( Align > 0u && (Align & (Align - 1u)) == 0u ));
+   BOOST_STATIC_ASSERT(( Align <= bmupd::alignment_of<bmupd::max_align_t>::value ));
+
+   typedef bmupd::inplace_vtable<Base> vtable_t;
+   #endif
+
+   public:
+   typedef Base         element_type;
+   typedef Base*        pointer;
+   typedef Base&        reference;
+
+   //! The size of the inline buffer
+   static const std::size_t buffer_size = Size;
+   //! The alignment of the inline buffer
+   static const std::size_t buffer_alignment = Align;
+
+   //! <b>Returns</b>: true if objects of type D are stored inline.
+   //!
+   template<class D>
+   struct fits_inline
+   {
+      static const bool value = bmupd::inplace_fits<D, Size, Align>::value;
+   };
+
+   //! <b>Effects</b>: Constructs an empty inplace_unique.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr</tt>.
+   inplace_unique() BOOST_NOEXCEPT
+      : m_ptr(), m_vtable()
+   {}
+
+   //! <b>Effects</b>: Same as <tt>inplace_unique()</tt> (default constructor).
+   //!
+   inplace_unique(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+      : m_ptr(), m_vtable()
+   {}
+
+   //! <b>Effects</b>: Constructs an inplace_unique by transferring ownership from x to *this,
+   //!   relocating the owned object if it was stored inline.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   inplace_unique(BOOST_RV_REF(inplace_unique) x) BOOST_NOEXCEPT
+      : m_ptr(), m_vtable()
+   {  this->steal(x);  }
+
+   //! <b>Effects</b>: Destroys the owned object, if any, and transfers ownership from x to *this,
+   //!   relocating the owned object if it was stored inline.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   inplace_unique& operator=(BOOST_RV_REF(inplace_unique) x) BOOST_NOEXCEPT
+   {
+      if(this != &x){
+         this->reset();
+         this->steal(x);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: <tt>reset()</tt>.
+   //!
+   inplace_unique& operator=(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+   {  this->reset(); return *this;  }
+
+   //! <b>Effects</b>: Destroys the owned object, if any.
+   //!
+   ~inplace_unique()
+   {  this->reset();  }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED) || !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+   //! <b>Effects</b>: Destroys the owned object, if any, and constructs an object of type D
+   //!   with <tt>D(std::forward<Args>(args)...)</tt>, inline if <tt>fits_inline<D>::value</tt>,
+   //!   otherwise in memory allocated with <tt>new</tt>.
+   //!
+   //! <b>Returns</b>: A reference to the new object.
+   //!
+   //! <b>Throws</b>: If the constructor of D or the allocation throws. In that case <tt>get() == nullptr</tt>.
+   template<class D, class... Args>
+   D &emplace(BOOST_FWD_REF(Args)... args)
+   {
+      this->template check_type<D>();
+      this->reset();
+      D *d;
+      if(fits_inline<D>::value){
+         d = ::new(static_cast<void*>(m_storage.data)) D(::boost::forward<Args>(args)...);
+         m_vtable = &bmupd::inplace_ops<Base, D>::vtable;
+      }
+      else{
+         d = new D(::boost::forward<Args>(args)...);
+      }
+      m_ptr = d;
+      return *d;
+   }
+
+   #else
+
+   #define BOOST_PP_LOCAL_MACRO(n) \
+   template<class D BOOST_PP_ENUM_TRAILING_PARAMS(n, class P) > \
+   D &emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_LIST, _)) \
+   { \
+      this->template check_type<D>(); \
+      this->reset(); \
+      D *d; \
+      if(fits_inline<D>::value){ \
+         d = ::new(static_cast<void*>(m_storage.data)) D(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)); \
+         m_vtable = &bmupd::inplace_ops<Base, D>::vtable; \
+      } \
+      else{ \
+         d = new D(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)); \
+      } \
+      m_ptr = d; \
+      return *d; \
+   } \
+   //!
+
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+   #endif
+
+   //! <b>Returns</b>: A pointer to the owned object or nullptr if empty.
+   //!
+   pointer get() const BOOST_NOEXCEPT
+   {  return m_ptr;  }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>*get()</tt>.
+   reference operator*() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(m_ptr);
+      return *m_ptr;
+   }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>get()</tt>.
+   pointer operator->() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(m_ptr);
+      return m_ptr;
+   }
+
+   //! <b>Returns</b>: true if the owned object is stored in the inline buffer.
+   //!
+   bool is_inline() const BOOST_NOEXCEPT
+   {  return m_vtable != 0;  }
+
+   #ifdef BOOST_MOVE_DOXYGEN_INVOKED
+   //! <b>Returns</b>: Returns: get() != nullptr.
+   //!
+   explicit operator bool
+   #else
+   operator bmupd::explicit_bool_arg
+   #endif
+      ()const BOOST_NOEXCEPT
+   {
+      return m_ptr
+         ? &bmupd::bool_conversion::for_bool
+         : bmupd::explicit_bool_arg(0);
+   }
+
+   //! <b>Effects</b>: Destroys the owned object, if any.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr</tt>.
+   void reset() BOOST_NOEXCEPT
+   {
+      if(m_vtable){
+         m_vtable->destroy(m_storage.data);
+         m_vtable = 0;
+      }
+      else{
+         delete m_ptr;
+      }
+      m_ptr = 0;
+   }
+
+   //! <b>Effects</b>: Exchanges the owned objects of *this and x.
+   //!
+   void swap(inplace_unique &x) BOOST_NOEXCEPT
+   {
+      inplace_unique tmp(::boost::move(x));
+      x = ::boost::move(*this);
+      *this = ::boost::move(tmp);
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+
+   template<class D>
+   static void check_type()
+   {
+      //D is deleted through Base* when allocated in the heap. If D derives
+      //from Base and Base has no virtual destructor, then you have a problem
+      BOOST_STATIC_ASSERT(( fits_inline<D>::value ||
+         !::boost::move_upmu::missing_virtual_destructor< default_delete<Base>, D >::value ));
+   }
+
+   void steal(inplace_unique &x) BOOST_NOEXCEPT
+   {
+      if(x.m_vtable){
+         m_ptr = x.m_vtable->relocate(m_storage.data, x.m_storage.data);
+         m_vtable = x.m_vtable;
+         x.m_vtable = 0;
+      }
+      else{
+         m_ptr = x.m_ptr;
+      }
+      x.m_ptr = 0;
+   }
+
+   Base *m_ptr;
+   const vtable_t *m_vtable;
+   bmupd::max_aligned_storage<Size> m_storage;
+   #endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+};
+
+//! <b>Effects</b>: Calls <tt>x.swap(y)</tt>.
+//!
+template <class Base, std::size_t Size, std::size_t Align>
+inline void swap(inplace_unique<Base, Size, Align> &x, inplace_unique<Base, Size, Align> &y) BOOST_NOEXCEPT
+{  x.swap(y); }
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_INPLACE_UNIQUE_HPP_INCLUDED
@@ -18,12 +18,7 @@
 #include <cstddef>   //for std::size_t
 #include <boost/move/detail/unique_ptr_meta_utils.hpp>
 
-#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
-#include <boost/preprocessor/iteration/local.hpp>
-#include <boost/preprocessor/repetition/enum_trailing_params.hpp>
-#include <boost/preprocessor/repetition/enum.hpp>
-#include <boost/preprocessor/cat.hpp>
-#endif
+#include <boost/move/detail/fwd_macros.hpp>
 
 //!\file
 //! Defines "make_unique" functions, which are factories to create instances
@@ -77,31 +72,19 @@ inline BOOST_MOVE_DOC1ST(unique_ptr<T>,
 {  return unique_ptr<T>(new T(::boost::forward<Args>(args)...));  }
 
 #else
-   #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
-      #define BOOST_MOVE_PP_PARAM_LIST(z, n, data) \
-      BOOST_PP_CAT(P, n) && BOOST_PP_CAT(p, n) \
-      //!
-   #else
-      #define BOOST_MOVE_PP_PARAM_LIST(z, n, data) \
-      const BOOST_PP_CAT(P, n) & BOOST_PP_CAT(p, n) \
-      //!
-   #endif   //#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
-
-   #define BOOST_MOVE_PP_PARAM_FORWARD(z, n, data) \
-   ::boost::forward< BOOST_PP_CAT(P, n) >( BOOST_PP_CAT(p, n) ) \
-   //!
-
-   #define BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS 10
 
-   #define BOOST_PP_LOCAL_MACRO(n) \
+   //Non-const lvalues and rv<T> arguments are passed to T's constructor as-is
+   #define BOOST_MOVE_MAKE_UNIQUE_CODE(n, mask) \
    template<class T BOOST_PP_ENUM_TRAILING_PARAMS(n, class P) > \
    typename ::boost::move_upmu::unique_ptr_if<T>::t_is_not_array \
-      make_unique(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_LIST, _)) \
-   {  return unique_ptr<T>(new T(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)));  } \
+      make_unique(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_LIST_MASK, mask)) \
+   {  return unique_ptr<T>(new T(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD_MASK, mask)));  } \
    //!
 
+   #define BOOST_PP_LOCAL_MACRO(n) BOOST_MOVE_PP_FOR_EACH_MASK(n, BOOST_MOVE_MAKE_UNIQUE_CODE)
    #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
    #include BOOST_PP_LOCAL_ITERATE()
+   #undef BOOST_MOVE_MAKE_UNIQUE_CODE
 
 #endif
 
@@ -0,0 +1,213 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_RECYCLE_DELETE_HPP_INCLUDED
+#define BOOST_MOVE_RECYCLE_DELETE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
+
+#include <cstddef>   //For std::size_t
+#include <vector>
+
+//!\file
+//! Describes <tt>recycle_delete</tt>, a deleter for <tt>unique_ptr</tt> that returns objects
+//! to a pool instead of destroying them, the default pool <tt>recycle_pool</tt> and the
+//! <tt>recycle_reset</tt> customization point that puts objects back in a reusable state.
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>recycle_reset</tt> is the default policy used by <tt>recycle_pool</tt>
+//!to put a returned object in a reusable state. It calls <tt>reset(t)</tt>, found by
+//!argument dependent lookup, so a type can be made recyclable by providing that function
+//!in its namespace. Alternatively, <tt>recycle_reset</tt> can be specialized.
+//!
+//!After being reset the object shall be equivalent to a default constructed one,
+//!but it may keep its resources (e.g. the capacity of its buffers).
+template<class T>
+struct recycle_reset
+{
+   //! <b>Effects</b>: reset(t)
+   //!
+   void operator()(T &t) const
+   {  reset(t);  }
+};
+
+template<class T, class Pool>
+struct recycle_delete;
+
+//!The class template <tt>recycle_pool</tt> keeps a free list of default constructed
+//!objects of type T. Objects are handed out by <tt>acquire()</tt> owned by a
+//!<tt>unique_ptr<T, recycle_delete<T, recycle_pool> ></tt>, whose deleter resets them
+//!with <tt>Reset</tt> and returns them to the pool instead of destroying them.
+//!
+//!Once the free list holds enough objects, the steady state does not allocate or construct objects.
+//!
+//!The pool is not thread-safe and must outlive the objects it hands out.
+//!
+//! \tparam T The type of the pooled objects. Must be default constructible.
+//! \tparam Reset A function object that puts a T back in a reusable state.
+template<class T, class Reset = recycle_reset<T> >
+class recycle_pool
+{
+   recycle_pool(const recycle_pool &);
+   recycle_pool &operator=(const recycle_pool &);
+
+   public:
+   typedef T                                                      element_type;
+   typedef Reset                                                  reset_type;
+   typedef recycle_delete<T, recycle_pool>                        deleter_type;
+   typedef ::boost::movelib::unique_ptr<T, deleter_type>          unique_ptr_type;
+
+   //! <b>Effects</b>: Constructs an empty pool that keeps at most max_free objects
+   //!   in its free list. Objects returned while the free list is full are destroyed.
+   explicit recycle_pool(std::size_t max_free = std::size_t(-1), const Reset &r = Reset())
+      : m_free(), m_max_free(max_free), m_reset(r)
+   {}
+
+   //! <b>Effects</b>: Destroys the objects in the free list.
+   //!
+   ~recycle_pool()
+   {  this->shrink_to(0);  }
+
+   //! <b>Effects</b>: Takes an object from the free list or, if empty,
+   //!   default constructs a new one.
+   //!
+   //! <b>Returns</b>: The object owned by a unique_ptr that returns it to this pool.
+   //!
+   //! <b>Throws</b>: If the allocation or the construction of a new object throws.
+   unique_ptr_type acquire()
+   {
+      if(m_free.empty()){
+         return unique_ptr_type(new T, deleter_type(*this));
+      }
+      T *const p = m_free.back();
+      m_free.pop_back();
+      return unique_ptr_type(p, deleter_type(*this));
+   }
+
+   //! <b>Effects</b>: Default constructs objects until the free list holds
+   //!   min(n, max_free()) objects.
+   void reserve(std::size_t n)
+   {
+      n = n < m_max_free ? n : m_max_free;
+      m_free.reserve(n);
+      while(m_free.size() < n){
+         m_free.push_back(new T);
+      }
+   }
+
+   //! <b>Effects</b>: Resets p and stores it in the free list. If the free list is full,
+   //!   or if resetting or storing the object throws, p is destroyed instead.
+   void recycle(T *p) BOOST_NOEXCEPT
+   {
+      BOOST_TRY{
+         if(m_free.size() < m_max_free){
+            m_reset(*p);
+            m_free.push_back(p);
+            return;
+         }
+      }
+      BOOST_CATCH(...){
+      }
+      BOOST_CATCH_END
+      delete p;
+   }
+
+   //! <b>Effects</b>: Destroys objects from the free list until it holds at most n objects.
+   //!
+   void shrink_to(std::size_t n) BOOST_NOEXCEPT
+   {
+      while(m_free.size() > n){
+         delete m_free.back();
+         m_free.pop_back();
+      }
+   }
+
+   //! <b>Returns</b>: The number of objects in the free list.
+   //!
+   std::size_t free_count() const BOOST_NOEXCEPT
+   {  return m_free.size();  }
+
+   //! <b>Returns</b>: The maximum number of objects kept in the free list.
+   //!
+   std::size_t max_free() const BOOST_NOEXCEPT
+   {  return m_max_free;  }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   std::vector<T*> m_free;
+   std::size_t m_max_free;
+   Reset m_reset;
+   #endif
+};
+
+//!The class template <tt>recycle_delete</tt> is a deleter for <tt>unique_ptr</tt> that
+//!returns the owned object to a pool instead of destroying it, calling
+//!<tt>pool.recycle(p)</tt>.
+//!
+//!A default constructed <tt>recycle_delete</tt> has no associated pool and destroys
+//!objects with <tt>delete</tt>, so that a default constructed <tt>unique_ptr</tt>
+//!can be reset with objects not obtained from a pool.
+//!
+//! \tparam T The type of the recycled objects. Arrays are not supported.
+//! \tparam Pool A type with a <tt>recycle(T*)</tt> member function, e.g. <tt>recycle_pool<T></tt>.
+template<class T, class Pool = recycle_pool<T> >
+struct recycle_delete
+{
+   BOOST_STATIC_ASSERT(( !bmupmu::is_array<T>::value ));
+
+   typedef Pool pool_type;
+
+   //! <b>Effects</b>: Constructs a deleter with no associated pool.
+   //!
+   recycle_delete() BOOST_NOEXCEPT
+      : m_pool()
+   {}
+
+   //! <b>Effects</b>: Constructs a deleter that returns objects to pool.
+   //!
+   explicit recycle_delete(Pool &pool) BOOST_NOEXCEPT
+      : m_pool(&pool)
+   {}
+
+   //! <b>Effects</b>: If ptr is not null, calls <tt>pool().recycle(ptr)</tt>
+   //!   or <tt>delete ptr</tt> if there is no associated pool.
+   void operator()(T* ptr) const BOOST_NOEXCEPT
+   {
+      //T must be a complete type
+      BOOST_STATIC_ASSERT(sizeof(T) > 0);
+      if(ptr){
+         if(m_pool)  m_pool->recycle(ptr);
+         else        delete ptr;
+      }
+   }
+
+   //! <b>Returns</b>: A pointer to the associated pool or null.
+   //!
+   Pool *pool() const BOOST_NOEXCEPT
+   {  return m_pool;  }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   Pool *m_pool;
+   #endif
+};
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_RECYCLE_DELETE_HPP_INCLUDED
@@ -0,0 +1,322 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_RELATIVE_PTR_HPP_INCLUDED
+#define BOOST_MOVE_RELATIVE_PTR_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/detail/unique_ptr_meta_utils.hpp>
+#include <boost/move/default_delete.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>   //For std::size_t, std::ptrdiff_t
+#include <iterator>  //For std::random_access_iterator_tag
+
+//!\file
+//! Describes <tt>relative_ptr</tt>, a pointer that stores the distance to the pointee from its own
+//! address, so that it remains valid when the memory that holds both is mapped at a different address.
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>relative_ptr</tt> is a smart pointer that stores the offset from its own address
+//!to the pointee instead of an absolute address. Structures whose internal pointers are relative_ptrs
+//!remain valid when the memory holding them is mapped at a different base address (e.g. a shared memory
+//!segment or a memory mapped file), without any pointer fix-up.
+//!
+//!A relative_ptr can be used as the <tt>pointer</tt> type of a <tt>unique_ptr</tt> deleter, so that
+//!<tt>unique_ptr<T, D></tt> objects can be stored inside such segments.
+//!
+//!As the offset depends on the address of the relative_ptr, copies recompute it, so relative_ptr is not
+//!trivially copyable: a relative_ptr can be copied with <tt>memcpy</tt> only together with its pointee.
+//!A relative_ptr can't point to the byte following its own address, as that offset represents the null pointer.
+//!
+//! \tparam T The pointee type. It can be cv-qualified or void. As with raw pointers, a
+//!   relative_ptr to void can't be dereferenced, indexed or used in pointer arithmetic.
+template<class T>
+class relative_ptr
+{
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   struct nat {};
+   typedef typename bmupmu::add_lvalue_reference<T>::type        reference_t;
+   //reference_t is void for void pointees, which is not a valid parameter type
+   typedef typename bmupmu::if_c
+      <bmupmu::is_lvalue_reference<reference_t>::value, reference_t, nat&>::type pointer_to_arg_t;
+   #endif
+
+   public:
+   typedef T                                                      element_type;
+   typedef T*                                                     pointer;
+   typedef typename bmupmu::remove_cv<T>::type                    value_type;
+   typedef BOOST_MOVE_SEEDOC(reference_t)                         reference;
+   typedef std::ptrdiff_t                                         difference_type;
+   typedef std::random_access_iterator_tag                        iterator_category;
+
+   //! <b>Effects</b>: Constructs a null relative_ptr.
+   //!
+   relative_ptr() BOOST_NOEXCEPT
+      : m_off(1)
+   {}
+
+   //! <b>Effects</b>: Constructs a null relative_ptr.
+   //!
+   relative_ptr(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+      : m_off(1)
+   {}
+
+   //! <b>Effects</b>: Constructs a relative_ptr that points to p.
+   //!
+   relative_ptr(T *p) BOOST_NOEXCEPT
+      : m_off(to_offset(this, p))
+   {}
+
+   //! <b>Effects</b>: Constructs a relative_ptr that points to the pointee of x.
+   //!
+   relative_ptr(const relative_ptr &x) BOOST_NOEXCEPT
+      : m_off(to_offset(this, x.get()))
+   {}
+
+   //! <b>Effects</b>: Constructs a relative_ptr that points to the pointee of x.
+   //!
+   //! <b>Remarks</b>: This constructor shall not participate in overload resolution unless U* is implicitly convertible to T*.
+   template<class U>
+   relative_ptr(const relative_ptr<U> &x
+      BOOST_MOVE_DOCIGN(BOOST_MOVE_I typename bmupmu::enable_if_c<bmupmu::is_convertible<U* BOOST_MOVE_I T*>::value BOOST_MOVE_I nat>::type* = 0)) BOOST_NOEXCEPT
+      : m_off(to_offset(this, x.get()))
+   {}
+
+   //! <b>Effects</b>: Points to the pointee of x.
+   //!
+   relative_ptr &operator=(const relative_ptr &x) BOOST_NOEXCEPT
+   {
+      m_off = to_offset(this, x.get());
+      return *this;
+   }
+
+   //! <b>Effects</b>: Points to p.
+   //!
+   relative_ptr &operator=(T *p) BOOST_NOEXCEPT
+   {
+      m_off = to_offset(this, p);
+      return *this;
+   }
+
+   //! <b>Effects</b>: Points to the pointee of x.
+   //!
+   //! <b>Remarks</b>: This operator shall not participate in overload resolution unless U* is implicitly convertible to T*.
+   template<class U>
+   BOOST_MOVE_DOC1ST(relative_ptr&, typename bmupmu::enable_if_c<bmupmu::is_convertible<U* BOOST_MOVE_I T*>::value BOOST_MOVE_I relative_ptr&>::type)
+      operator=(const relative_ptr<U> &x) BOOST_NOEXCEPT
+   {
+      m_off = to_offset(this, x.get());
+      return *this;
+   }
+
+   //! <b>Returns</b>: A raw pointer to the pointee or null.
+   //!
+   T *get() const BOOST_NOEXCEPT
+   {
+      return m_off == 1 ? static_cast<T*>(0)
+         : reinterpret_cast<T*>(reinterpret_cast<std::size_t>(this) + std::size_t(m_off));
+   }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>*get()</tt>.
+   reference operator*() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(m_off != 1);
+      return *this->get();
+   }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>get()</tt>.
+   T *operator->() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(m_off != 1);
+      return this->get();
+   }
+
+   //! <b>Returns</b>: <tt>get()[i]</tt>.
+   //!
+   reference operator[](std::ptrdiff_t i) const BOOST_NOEXCEPT
+   {  return this->get()[i];  }
+
+   #ifdef BOOST_MOVE_DOXYGEN_INVOKED
+   //! <b>Returns</b>: Returns: get() != nullptr.
+   //!
+   explicit operator bool
+   #else
+   operator bmupd::explicit_bool_arg
+   #endif
+      ()const BOOST_NOEXCEPT
+   {
+      return m_off != 1
+         ? &bmupd::bool_conversion::for_bool
+         : bmupd::explicit_bool_arg(0);
+   }
+
+   //! <b>Returns</b>: <tt>get() == nullptr</tt>.
+   //!
+   bool operator!() const BOOST_NOEXCEPT
+   {  return m_off == 1;  }
+
+   //! <b>Returns</b>: A relative_ptr pointing to r.
+   //!
+   //! <b>Remarks</b>: Not available if T is void.
+   static relative_ptr pointer_to(BOOST_MOVE_DOC1ST(reference, pointer_to_arg_t) r) BOOST_NOEXCEPT
+   {  return relative_ptr(&r);  }
+
+   //! <b>Effects</b>: Advances the pointer n elements.
+   //!
+   relative_ptr &operator+=(std::ptrdiff_t n) BOOST_NOEXCEPT
+   {  m_off += n*std::ptrdiff_t(sizeof(T)); return *this;  }
+
+   //! <b>Effects</b>: Moves the pointer back n elements.
+   //!
+   relative_ptr &operator-=(std::ptrdiff_t n) BOOST_NOEXCEPT
+   {  m_off -= n*std::ptrdiff_t(sizeof(T)); return *this;  }
+
+   //! <b>Effects</b>: <tt>*this += 1</tt>.
+   //!
+   relative_ptr &operator++() BOOST_NOEXCEPT
+   {  return *this += 1;  }
+
+   //! <b>Effects</b>: <tt>*this += 1</tt>.
+   //!
+   //! <b>Returns</b>: The previous value.
+   relative_ptr operator++(int) BOOST_NOEXCEPT
+   {  relative_ptr tmp(*this); ++*this; return tmp;  }
+
+   //! <b>Effects</b>: <tt>*this -= 1</tt>.
+   //!
+   relative_ptr &operator--() BOOST_NOEXCEPT
+   {  return *this -= 1;  }
+
+   //! <b>Effects</b>: <tt>*this -= 1</tt>.
+   //!
+   //! <b>Returns</b>: The previous value.
+   relative_ptr operator--(int) BOOST_NOEXCEPT
+   {  relative_ptr tmp(*this); --*this; return tmp;  }
+
+   //! <b>Returns</b>: A relative_ptr pointing n elements after x.
+   //!
+   friend relative_ptr operator+(relative_ptr x, std::ptrdiff_t n) BOOST_NOEXCEPT
+   {  return relative_ptr(x.get() + n);  }
+
+   //! <b>Returns</b>: A relative_ptr pointing n elements after x.
+   //!
+   friend relative_ptr operator+(std::ptrdiff_t n, relative_ptr x) BOOST_NOEXCEPT
+   {  return relative_ptr(x.get() + n);  }
+
+   //! <b>Returns</b>: A relative_ptr pointing n elements before x.
+   //!
+   friend relative_ptr operator-(relative_ptr x, std::ptrdiff_t n) BOOST_NOEXCEPT
+   {  return relative_ptr(x.get() - n);  }
+
+   //! <b>Returns</b>: <tt>x.get() - y.get()</tt>.
+   //!
+   friend std::ptrdiff_t operator-(const relative_ptr &x, const relative_ptr &y) BOOST_NOEXCEPT
+   {  return x.get() - y.get();  }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   static std::ptrdiff_t to_offset(const volatile void *self, const volatile void *p) BOOST_NOEXCEPT
+   {
+      //Addresses are subtracted as integers, as the pointee is not part of the
+      //same object as *this. An offset of 1 is reserved for the null pointer
+      const std::ptrdiff_t off = p
+         ? std::ptrdiff_t(reinterpret_cast<std::size_t>(p) - reinterpret_cast<std::size_t>(self)) : 1;
+      BOOST_ASSERT(!p || off != 1);
+      return off;
+   }
+
+   std::ptrdiff_t m_off;
+   #endif
+};
+
+//! <b>Returns</b>: <tt>x.get() == y.get()</tt>.
+//!
+template<class T, class U>
+inline bool operator==(const relative_ptr<T> &x, const relative_ptr<U> &y) BOOST_NOEXCEPT
+{  return x.get() == y.get();  }
+
+//! <b>Returns</b>: <tt>x.get() != y.get()</tt>.
+//!
+template<class T, class U>
+inline bool operator!=(const relative_ptr<T> &x, const relative_ptr<U> &y) BOOST_NOEXCEPT
+{  return x.get() != y.get();  }
+
+//! <b>Returns</b>: <tt>x.get() < y.get()</tt>.
+//!
+template<class T, class U>
+inline bool operator<(const relative_ptr<T> &x, const relative_ptr<U> &y) BOOST_NOEXCEPT
+{  return x.get() < y.get();  }
+
+//! <b>Returns</b>: <tt>x.get() <= y.get()</tt>.
+//!
+template<class T, class U>
+inline bool operator<=(const relative_ptr<T> &x, const relative_ptr<U> &y) BOOST_NOEXCEPT
+{  return x.get() <= y.get();  }
+
+//! <b>Returns</b>: <tt>x.get() > y.get()</tt>.
+//!
+template<class T, class U>
+inline bool operator>(const relative_ptr<T> &x, const relative_ptr<U> &y) BOOST_NOEXCEPT
+{  return x.get() > y.get();  }
+
+//! <b>Returns</b>: <tt>x.get() >= y.get()</tt>.
+//!
+template<class T, class U>
+inline bool operator>=(const relative_ptr<T> &x, const relative_ptr<U> &y) BOOST_NOEXCEPT
+{  return x.get() >= y.get();  }
+
+//! <b>Returns</b>: <tt>x.get() == p</tt>.
+//!
+template<class T>
+inline bool operator==(const relative_ptr<T> &x, T *p) BOOST_NOEXCEPT
+{  return x.get() == p;  }
+
+//! <b>Returns</b>: <tt>p == x.get()</tt>.
+//!
+template<class T>
+inline bool operator==(T *p, const relative_ptr<T> &x) BOOST_NOEXCEPT
+{  return p == x.get();  }
+
+//! <b>Returns</b>: <tt>x.get() != p</tt>.
+//!
+template<class T>
+inline bool operator!=(const relative_ptr<T> &x, T *p) BOOST_NOEXCEPT
+{  return x.get() != p;  }
+
+//! <b>Returns</b>: <tt>p != x.get()</tt>.
+//!
+template<class T>
+inline bool operator!=(T *p, const relative_ptr<T> &x) BOOST_NOEXCEPT
+{  return p != x.get();  }
+
+//! <b>Effects</b>: Exchanges the pointees of x and y.
+//!
+template<class T>
+inline void swap(relative_ptr<T> &x, relative_ptr<T> &y) BOOST_NOEXCEPT
+{
+   T *const tmp = x.get();
+   x = y;
+   y = tmp;
+}
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_RELATIVE_PTR_HPP_INCLUDED
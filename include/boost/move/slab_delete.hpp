@@ -0,0 +1,401 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_SLAB_DELETE_HPP_INCLUDED
+#define BOOST_MOVE_SLAB_DELETE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/default_delete.hpp>
+#include <boost/move/detail/memory_utils.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/type_traits/is_polymorphic.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+
+#if  !defined(BOOST_NO_CXX11_THREAD_LOCAL)            && \
+     !defined(BOOST_NO_CXX11_HDR_ATOMIC)              && \
+     !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)      && \
+     !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   #define BOOST_MOVE_HAS_SLAB_DELETE
+#endif
+
+#if defined(BOOST_MOVE_HAS_SLAB_DELETE)
+   #include <atomic>
+   #include <cstddef>   //For std::size_t
+   #include <new>       //For placement new
+#endif
+
+//!\file
+//! Describes <tt>make_unique_slab</tt> and <tt>slab_delete</tt>, a thread-local slab allocator
+//! for small objects that are created by one thread and destroyed by another one.
+//!
+//! Only available if the compiler supports C++11 atomics, variadic templates and <tt>thread_local</tt>.
+
+//! Size in bytes of the blocks (slabs) the objects are carved from. Must be a power of two.
+//! Slabs are aligned to their size, so the slab of an object is found masking its address.
+#ifndef BOOST_MOVE_SLAB_SIZE
+   #define BOOST_MOVE_SLAB_SIZE 65536u
+#endif
+
+#if defined(BOOST_MOVE_HAS_SLAB_DELETE) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace move_upd {
+
+BOOST_STATIC_ASSERT(( BOOST_MOVE_SLAB_SIZE && !(BOOST_MOVE_SLAB_SIZE & (BOOST_MOVE_SLAB_SIZE - 1u)) ));
+
+//////////////////////////////////////
+//            slab_heap
+//////////////////////////////////////
+
+//Per-thread, per-size class heap. Heaps are never freed: when a thread exits its heap
+//(with its slabs and the blocks freed by other threads) is adopted by the next thread
+//that allocates objects of the same size class.
+struct slab_heap
+{
+   struct free_block
+   {  free_block *next;  };
+
+   //Placed at the start of each slab
+   struct slab_header
+   {  slab_heap *heap;  };
+
+   static const std::size_t slab_size   = BOOST_MOVE_SLAB_SIZE;
+   static const std::size_t header_size =
+      (sizeof(slab_header) + alignment_of<max_align_t>::value - 1u) & ~(alignment_of<max_align_t>::value - 1u);
+
+   //Blocks freed by other threads, a lock-free stack. Other threads only push
+   //and the owner detaches the whole list, so there is no ABA problem.
+   std::atomic<free_block*> remote;
+   //Identity of the owning thread, null if the heap is orphaned
+   std::atomic<const void*> owner;
+   std::atomic<bool> in_use;
+   slab_heap *next;
+   const std::size_t block_size;
+   //Only accessed by the owner
+   free_block *local;
+   char *bump;
+   char *bump_end;
+
+   explicit slab_heap(std::size_t bsize)
+      : remote(0), owner(0), in_use(true), next(0), block_size(bsize), local(0), bump(0), bump_end(0)
+   {}
+
+   static slab_heap &heap_of(void *p)
+   {
+      //Integer arithmetic, the slab is a different object than the block
+      std::size_t const addr = reinterpret_cast<std::size_t>(p) & ~(slab_size - 1u);
+      return *reinterpret_cast<slab_header*>(addr)->heap;
+   }
+
+   void *allocate()
+   {
+      if(!local){
+         this->reclaim();
+      }
+      if(local){
+         free_block *const b = local;
+         local = b->next;
+         return b;
+      }
+      if(bump == bump_end){
+         this->new_slab();
+      }
+      void *const p = bump;
+      bump += block_size;
+      return p;
+   }
+
+   void deallocate_local(void *p) BOOST_NOEXCEPT
+   {
+      free_block *const b = static_cast<free_block*>(p);
+      b->next = local;
+      local = b;
+   }
+
+   void deallocate_remote(void *p) BOOST_NOEXCEPT
+   {
+      free_block *const b = static_cast<free_block*>(p);
+      free_block *old_head = remote.load(std::memory_order_relaxed);
+      do{
+         b->next = old_head;
+      } while(!remote.compare_exchange_weak(old_head, b, std::memory_order_release, std::memory_order_relaxed));
+   }
+
+   //Moves the blocks freed by other threads to the local list. Returns their number.
+   std::size_t reclaim() BOOST_NOEXCEPT
+   {
+      //Cheap check first, to avoid a read-modify-write when there is nothing to reclaim
+      if(!remote.load(std::memory_order_relaxed)){
+         return 0;
+      }
+      free_block *b = remote.exchange(0, std::memory_order_acquire);
+      std::size_t n = 0;
+      while(b){
+         free_block *const nxt = b->next;
+         this->deallocate_local(b);
+         b = nxt;
+         ++n;
+      }
+      return n;
+   }
+
+   void new_slab()
+   {
+      char *const s = static_cast<char*>(raw_aligned_allocate(slab_size, slab_size));
+      ::new(static_cast<void*>(s)) slab_header();
+      reinterpret_cast<slab_header*>(s)->heap = this;
+      bump = s + header_size;
+      bump_end = bump + ((slab_size - header_size)/block_size)*block_size;
+   }
+};
+
+//Address identifying the calling thread while it is alive
+inline const void *slab_thread_id()
+{
+   static thread_local char id;
+   return &id;
+}
+
+//////////////////////////////////////
+//          slab_registry
+//////////////////////////////////////
+template<std::size_t BlockSize, class Dummy = void>
+struct slab_registry
+{
+   static std::atomic<slab_heap*> head;
+
+   static slab_heap *acquire()
+   {
+      slab_heap *r = 0;
+      //Adopt the heap of an exited thread
+      for(slab_heap *h = head.load(std::memory_order_acquire); h && !r; h = h->next){
+         bool expected = false;
+         if(!h->in_use.load(std::memory_order_relaxed) &&
+            h->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)){
+            r = h;
+         }
+      }
+      if(!r){
+         r = new slab_heap(BlockSize);
+         slab_heap *old_head = head.load(std::memory_order_relaxed);
+         do{
+            r->next = old_head;
+         } while(!head.compare_exchange_weak(old_head, r, std::memory_order_release, std::memory_order_relaxed));
+      }
+      r->owner.store(slab_thread_id(), std::memory_order_relaxed);
+      return r;
+   }
+
+   static void release(slab_heap *h)
+   {
+      h->reclaim();
+      h->owner.store(0, std::memory_order_relaxed);
+      h->in_use.store(false, std::memory_order_release);
+   }
+};
+
+template<std::size_t BlockSize, class Dummy>
+std::atomic<slab_heap*> slab_registry<BlockSize, Dummy>::head(0);
+
+template<std::size_t BlockSize>
+struct slab_thread_handle
+{
+   slab_heap *heap;
+
+   slab_thread_handle()
+      : heap(slab_registry<BlockSize>::acquire())
+   {}
+
+   ~slab_thread_handle()
+   {  slab_registry<BlockSize>::release(heap);  }
+};
+
+template<std::size_t BlockSize>
+inline slab_heap &this_thread_slab_heap()
+{
+   static thread_local slab_thread_handle<BlockSize> handle;
+   return *handle.heap;
+}
+
+//Objects of types with the same block size share heaps
+template<class T>
+struct slab_block_size
+{
+   static const std::size_t align = alignment_of<max_align_t>::value;
+   static const std::size_t raw   = sizeof(T) < sizeof(void*) ? sizeof(void*) : sizeof(T);
+   static const std::size_t value = (raw + align - 1u) & ~(align - 1u);
+   BOOST_STATIC_ASSERT(( alignment_of<T>::value <= align ));
+   BOOST_STATIC_ASSERT(( value <= (slab_heap::slab_size - slab_heap::header_size)/8u ));
+};
+
+inline void slab_deallocate(void *p) BOOST_NOEXCEPT
+{
+   slab_heap &h = slab_heap::heap_of(p);
+   //Only this thread can store its own id, so a relaxed load is enough
+   if(h.owner.load(std::memory_order_relaxed) == slab_thread_id()){
+      h.deallocate_local(p);
+   }
+   else{
+      h.deallocate_remote(p);
+   }
+}
+
+template<class T>
+class slab_construct_guard
+{
+   slab_construct_guard(const slab_construct_guard &);
+   slab_construct_guard &operator=(const slab_construct_guard &);
+
+   public:
+   slab_construct_guard()
+      : m_p(this_thread_slab_heap<slab_block_size<T>::value>().allocate())
+   {}
+
+   ~slab_construct_guard()
+   {
+      if(m_p){
+         slab_deallocate(m_p);
+      }
+   }
+
+   void *storage() const
+   {  return m_p;  }
+
+   void release()
+   {  m_p = 0;  }
+
+   private:
+   void *m_p;
+};
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>slab_delete</tt> is the deleter of the objects created by
+//!<tt>make_unique_slab</tt>. It is an empty class, so <tt>unique_ptr<T, slab_delete<T> ></tt>
+//!has the size of a pointer.
+//!
+//!Each thread carves the objects of each size class from its own slabs. When an object is
+//!destroyed by the thread that created it, its block goes to that thread's free list without
+//!synchronization. When it is destroyed by another thread, the block is pushed to a lock-free
+//!list of the owning heap, which the owning thread reclaims in a single batch when its free
+//!list runs out or when <tt>reclaim()</tt> is called. This avoids the lock contention and
+//!cache line transfers that many allocators suffer in producer/consumer pipelines.
+//!
+//!When a thread exits, its heap is adopted by the next thread that creates objects of the same
+//!size class. Slabs are never returned to the system.
+//!
+//!Only pointers obtained from <tt>make_unique_slab</tt> can be deleted.
+//!
+//! \tparam T The type to be deleted. Arrays are not supported.
+template <class T>
+struct slab_delete
+{
+   BOOST_STATIC_ASSERT(( !bmupmu::is_array<T>::value ));
+
+   //! Default constructor.
+   //!
+   slab_delete() BOOST_NOEXCEPT
+   {}
+
+   //! <b>Effects</b>: Constructs a slab_delete object from another <tt>slab_delete<U></tt> object.
+   //!
+   //! <b>Remarks</b>: This constructor shall not participate in overload resolution unless
+   //!   U* is implicitly convertible to T*.
+   template <class U>
+   slab_delete(const slab_delete<U>&
+      BOOST_MOVE_DOCIGN(BOOST_MOVE_I typename bmupd::enable_def_del<U BOOST_MOVE_I T>::type* =0)
+      ) BOOST_NOEXCEPT
+   {
+      //If U derives from T and T has no virtual destructor, then you have a problem
+      BOOST_STATIC_ASSERT(( !::boost::move_upmu::missing_virtual_destructor<default_delete<T>, U>::value ));
+   }
+
+   //! <b>Effects</b>: If ptr is not null, destroys the object and returns its block
+   //!   to the heap of the thread that created it.
+   //!
+   //! <b>Remarks</b>: If U is an incomplete type, the program is ill-formed.
+   template <class U>
+   BOOST_MOVE_DOC1ST(void, typename bmupd::enable_defdel_call<U BOOST_MOVE_I T BOOST_MOVE_I void>::type)
+      operator()(U* ptr) const BOOST_NOEXCEPT
+   {
+      //U must be a complete type
+      BOOST_STATIC_ASSERT(sizeof(U) > 0);
+      //If U derives from T and T has no virtual destructor, then you have a problem
+      BOOST_STATIC_ASSERT(( !::boost::move_upmu::missing_virtual_destructor<default_delete<T>, U>::value ));
+      T * const p = static_cast<T*>(ptr);
+      if(p){
+         //Find the block of the most derived object
+         void *const block = block_of(p);
+         p->~T();
+         bmupd::slab_deallocate(block);
+      }
+   }
+
+   //! <b>Effects</b>: Same as <tt>(*this)(static_cast<T*>(nullptr))</tt>.
+   //!
+   void operator()(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) const BOOST_NOEXCEPT
+   {  BOOST_STATIC_ASSERT(sizeof(T) > 0);  }
+
+   //! <b>Effects</b>: Moves the blocks of the calling thread's heap for objects of type T
+   //!   that were freed by other threads to its free list.
+   //!
+   //! <b>Returns</b>: The number of reclaimed blocks.
+   static std::size_t reclaim() BOOST_NOEXCEPT
+   {  return bmupd::this_thread_slab_heap<bmupd::slab_block_size<T>::value>().reclaim();  }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   template<class U>
+   static void *block_of(U *p, typename bmupmu::enable_if_c<::boost::is_polymorphic<U>::value>::type* = 0)
+   {  return dynamic_cast<void*>(p);  }
+
+   template<class U>
+   static void *block_of(U *p, typename bmupmu::enable_if_c<!::boost::is_polymorphic<U>::value>::type* = 0)
+   {  return const_cast<void*>(static_cast<const volatile void*>(p));  }
+   #endif
+};
+
+//! <b>Effects</b>: Constructs a T with <tt>T(std::forward<Args>(args)...)</tt> in a block
+//!   of the calling thread's slab heap for the size class of T.
+//!
+//! <b>Returns</b>: A <tt>unique_ptr<T, slab_delete<T> ></tt> owning the new object.
+//!
+//! <b>Throws</b>: std::bad_alloc if a new slab can't be allocated, or any exception thrown
+//!   by the constructor, in which case the block is returned to the heap.
+//!
+//! <b>Remarks</b>: The alignment of T can't be greater than the alignment of <tt>max_align_t</tt>.
+template<class T, class... Args>
+inline unique_ptr<T, slab_delete<T> > make_unique_slab(BOOST_FWD_REF(Args)... args)
+{
+   bmupd::slab_construct_guard<T> g;
+   T *const p = ::new(g.storage()) T(::boost::forward<Args>(args)...);
+   g.release();
+   return unique_ptr<T, slab_delete<T> >(p);
+}
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#endif   //#if defined(BOOST_MOVE_HAS_SLAB_DELETE) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_SLAB_DELETE_HPP_INCLUDED
@@ -0,0 +1,393 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+//! This header implements the opt-in move/copy accounting enabled defining
+//! <tt>BOOST_MOVE_ENABLE_TRACE</tt> before including any Boost.Move header.
+//!
+//! When enabled, per-type counters are fed by:
+//!   - <tt>boost::move</tt> when it casts an lvalue of a class type to an rvalue
+//!     (or an emulated <tt>::boost::rv<T>&</tt>). Moving an argument that is already
+//!     an rvalue and <tt>boost::forward</tt>, which only preserves the value category
+//!     of its argument, are not counted, so that each move is counted once.
+//!   - In compilers without rvalue references, the implicit conversion to
+//!     <tt>::boost::rv<T>&</tt> defined by <tt>BOOST_MOVABLE_BUT_NOT_COPYABLE</tt>,
+//!     <tt>BOOST_COPYABLE_AND_MOVABLE</tt> and <tt>BOOST_COPYABLE_AND_MOVABLE_ALT</tt>.
+//!   - In compilers without rvalue references, the <tt>operator=(TYPE &)</tt> defined by
+//!     <tt>BOOST_COPYABLE_AND_MOVABLE</tt>, which counts copy assignments from non-const lvalues.
+//!   - The <tt>BOOST_MOVE_TRACE_COPY_CONSTRUCT</tt>, <tt>BOOST_MOVE_TRACE_MOVE_CONSTRUCT</tt>,
+//!     <tt>BOOST_MOVE_TRACE_COPY_ASSIGN</tt> and <tt>BOOST_MOVE_TRACE_MOVE_ASSIGN</tt> hooks,
+//!     placed by the user in the bodies of the copy and move constructors and assignments.
+//!
+//! Limitations:
+//!   - Copy assignments from non-const lvalues in C++03 are the only copies or moves the library
+//!     sees by itself. Copy and move constructors, copy assignments from const lvalues and move assignments
+//!     are written by the user, and the rvalue casts that precede a move don't tell a construction
+//!     from an assignment (or from a function taking <tt>BOOST_RV_REF</tt>), so they go to a separate
+//!     counter. Those copies and moves are only counted by the hooks.
+//!   - An rvalue cast does not imply that a move was performed: the rvalue can be bound to a
+//!     <tt>const T&</tt> parameter and copied.
+//!   - <tt>std::move</tt>, implicit moves of C++11 compilers and <tt>BOOST_MOVE_USE_STANDARD_LIBRARY_MOVE</tt>
+//!     are not counted.
+//!   - Counters are updated with relaxed atomic operations if the compiler supports C++11 atomics.
+//!     Otherwise they are not thread-safe.
+//!
+//! When <tt>BOOST_MOVE_ENABLE_TRACE</tt> is not defined the hooks expand to nothing.
+
+#ifndef BOOST_MOVE_TRACE_HPP
+#define BOOST_MOVE_TRACE_HPP
+
+#include <boost/move/detail/config_begin.hpp>
+
+#if defined(BOOST_MOVE_ENABLE_TRACE) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+#include <boost/move/detail/meta_utils.hpp>
+#include <cstddef>   //for std::size_t
+#include <cstdio>    //for std::FILE, std::fprintf
+
+#if !defined(BOOST_NO_TYPEID)
+   #include <boost/core/demangle.hpp>
+   #include <typeinfo>
+#else
+   #include <boost/current_function.hpp>
+#endif
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+   #include <atomic>
+#endif
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost {
+namespace move_detail {
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+
+typedef std::atomic<std::size_t> move_trace_counter;
+typedef std::atomic<bool>        move_trace_flag;
+
+inline void move_trace_inc(move_trace_counter &c)
+{  c.fetch_add(1u, std::memory_order_relaxed);  }
+
+inline std::size_t move_trace_load(const move_trace_counter &c)
+{  return c.load(std::memory_order_relaxed);  }
+
+inline void move_trace_clear(move_trace_counter &c)
+{  c.store(0u, std::memory_order_relaxed);  }
+
+//Returns true if the flag was not set
+inline bool move_trace_set(move_trace_flag &f)
+{  return !f.load(std::memory_order_relaxed) && !f.exchange(true, std::memory_order_relaxed);  }
+
+#else
+
+typedef std::size_t move_trace_counter;
+typedef bool        move_trace_flag;
+
+inline void move_trace_inc(move_trace_counter &c)
+{  ++c;  }
+
+inline std::size_t move_trace_load(const move_trace_counter &c)
+{  return c;  }
+
+inline void move_trace_clear(move_trace_counter &c)
+{  c = 0u;  }
+
+inline bool move_trace_set(move_trace_flag &f)
+{  const bool r = !f;  f = true;  return r;  }
+
+#endif
+
+//Per-type record, zero initialized and registered on first use
+struct move_trace_record
+{
+   enum { copy_construct, move_construct, copy_assign, move_assign, rvalue_cast, num_counters };
+
+   move_trace_counter counters[num_counters];
+   move_trace_flag registered;
+   const char *(*name)();
+   move_trace_record *next;
+};
+
+template<class Dummy>
+struct move_trace_registry
+{
+   #if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+   static std::atomic<move_trace_record*> head;
+
+   static void push(move_trace_record &r)
+   {
+      move_trace_record *old_head = head.load(std::memory_order_relaxed);
+      do{
+         r.next = old_head;
+      } while(!head.compare_exchange_weak(old_head, &r, std::memory_order_release, std::memory_order_relaxed));
+   }
+
+   static move_trace_record *first()
+   {  return head.load(std::memory_order_acquire);  }
+   #else
+   static move_trace_record *head;
+
+   static void push(move_trace_record &r)
+   {  r.next = head;  head = &r;  }
+
+   static move_trace_record *first()
+   {  return head;  }
+   #endif
+};
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+template<class Dummy>
+std::atomic<move_trace_record*> move_trace_registry<Dummy>::head(0);
+#else
+template<class Dummy>
+move_trace_record *move_trace_registry<Dummy>::head = 0;
+#endif
+
+template<class T>
+struct move_trace_of
+{
+   static move_trace_record rec;
+
+   static const char *name()
+   {
+      #if !defined(BOOST_NO_TYPEID)
+      return typeid(T).name();
+      #else
+      return BOOST_CURRENT_FUNCTION;
+      #endif
+   }
+
+   static move_trace_record &get()
+   {
+      if(move_trace_set(rec.registered)){
+         rec.name = &move_trace_of<T>::name;
+         move_trace_registry<void>::push(rec);
+      }
+      return rec;
+   }
+
+   static void inc(std::size_t counter)
+   {  move_trace_inc(get().counters[counter]);  }
+
+   //Set while the copy assignment from non-const lvalues defined by BOOST_COPYABLE_AND_MOVABLE
+   //calls the user's copy assignment: the copy is already counted, so the first
+   //BOOST_MOVE_TRACE_COPY_ASSIGN hook must not count it again
+   static bool lvalue_copy_assign_counted;
+
+   static void copy_assign_hook()
+   {
+      if(lvalue_copy_assign_counted){
+         lvalue_copy_assign_counted = false;
+      }
+      else{
+         inc(move_trace_record::copy_assign);
+      }
+   }
+};
+
+template<class T>
+move_trace_record move_trace_of<T>::rec;
+
+template<class T>
+bool move_trace_of<T>::lvalue_copy_assign_counted = false;
+
+//Placed by BOOST_COPYABLE_AND_MOVABLE in its operator=(TYPE &) in compilers without rvalue references
+template<class T>
+struct move_trace_lvalue_copy_assign
+{
+   move_trace_lvalue_copy_assign()
+   {
+      move_trace_of<T>::inc(move_trace_record::copy_assign);
+      move_trace_of<T>::lvalue_copy_assign_counted = true;
+   }
+
+   ~move_trace_lvalue_copy_assign()
+   {  move_trace_of<T>::lvalue_copy_assign_counted = false;  }
+};
+
+//Called by boost::move, only class types are traced
+template<class T, bool = is_class_or_union<T>::value>
+struct move_trace_rvalue_cast_impl
+{
+   static void apply()
+   {  move_trace_of<T>::inc(move_trace_record::rvalue_cast);  }
+};
+
+template<class T>
+struct move_trace_rvalue_cast_impl<T, false>
+{
+   static void apply()
+   {}
+};
+
+template<class T>
+struct move_trace_remove_const
+{  typedef T type;  };
+
+template<class T>
+struct move_trace_remove_const<const T>
+{  typedef T type;  };
+
+//T can be a reference or an emulated rvalue reference
+template<class T>
+inline void move_trace_rvalue_cast()
+{
+   typedef typename move_trace_remove_const<typename remove_reference<T>::type>::type type;
+   move_trace_rvalue_cast_impl<type>::apply();
+}
+
+//boost::move<T>(T&&) only casts if the argument is an lvalue (T is an lvalue reference)
+template<class T>
+inline void move_trace_move()
+{
+   if(is_lvalue_reference<T>::value){
+      move_trace_rvalue_cast<T>();
+   }
+}
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost {
+
+//! Values of the counters of a type. See <tt>move_trace_counts_of</tt>.
+//!
+struct move_trace_counts
+{
+   //! Copy constructions reported by <tt>BOOST_MOVE_TRACE_COPY_CONSTRUCT</tt>.
+   std::size_t copy_constructions;
+   //! Move constructions reported by <tt>BOOST_MOVE_TRACE_MOVE_CONSTRUCT</tt>.
+   std::size_t move_constructions;
+   //! Copy assignments reported by <tt>BOOST_MOVE_TRACE_COPY_ASSIGN</tt> and, in compilers
+   //! without rvalue references, copy assignments from non-const lvalues of classes
+   //! marked with <tt>BOOST_COPYABLE_AND_MOVABLE</tt>.
+   std::size_t copy_assignments;
+   //! Move assignments reported by <tt>BOOST_MOVE_TRACE_MOVE_ASSIGN</tt>.
+   std::size_t move_assignments;
+   //! Lvalues cast to rvalues by <tt>boost::move</tt> and, in compilers without
+   //! rvalue references, temporaries converted to <tt>::boost::rv<T>&</tt>.
+   std::size_t rvalue_casts;
+};
+
+//! <b>Returns</b>: The current value of the counters of T.
+//!
+template<class T>
+inline move_trace_counts move_trace_counts_of()
+{
+   typedef ::boost::move_detail::move_trace_record record_t;
+   const record_t &r = ::boost::move_detail::move_trace_of<T>::rec;
+   move_trace_counts c;
+   c.copy_constructions = ::boost::move_detail::move_trace_load(r.counters[record_t::copy_construct]);
+   c.move_constructions = ::boost::move_detail::move_trace_load(r.counters[record_t::move_construct]);
+   c.copy_assignments   = ::boost::move_detail::move_trace_load(r.counters[record_t::copy_assign]);
+   c.move_assignments   = ::boost::move_detail::move_trace_load(r.counters[record_t::move_assign]);
+   c.rvalue_casts       = ::boost::move_detail::move_trace_load(r.counters[record_t::rvalue_cast]);
+   return c;
+}
+
+//! <b>Effects</b>: Sets to zero the counters of all types.
+//!
+inline void move_trace_reset()
+{
+   typedef ::boost::move_detail::move_trace_record record_t;
+   for(record_t *r = ::boost::move_detail::move_trace_registry<void>::first(); r; r = r->next){
+      for(std::size_t i = 0; i != record_t::num_counters; ++i){
+         ::boost::move_detail::move_trace_clear(r->counters[i]);
+      }
+   }
+}
+
+//! <b>Effects</b>: Prints to out a line with the counters of each type that has been traced:
+//!   copy constructions, move constructions, copy assignments, move assignments and rvalue casts.
+//!
+//! <b>Returns</b>: The number of types printed.
+inline std::size_t move_trace_dump(std::FILE *out)
+{
+   typedef ::boost::move_detail::move_trace_record record_t;
+   using ::boost::move_detail::move_trace_load;
+   std::size_t n = 0;
+   std::fprintf(out, "%10s %10s %10s %10s %10s  %s\n", "copy_ctor", "move_ctor", "copy_asgn", "move_asgn", "rvalue", "type");
+   for(record_t *r = ::boost::move_detail::move_trace_registry<void>::first(); r; r = r->next, ++n){
+      std::fprintf( out, "%10lu %10lu %10lu %10lu %10lu  %s\n"
+                  , (unsigned long)move_trace_load(r->counters[record_t::copy_construct])
+                  , (unsigned long)move_trace_load(r->counters[record_t::move_construct])
+                  , (unsigned long)move_trace_load(r->counters[record_t::copy_assign])
+                  , (unsigned long)move_trace_load(r->counters[record_t::move_assign])
+                  , (unsigned long)move_trace_load(r->counters[record_t::rvalue_cast])
+                  #if !defined(BOOST_NO_TYPEID)
+                  , ::boost::core::demangle(r->name()).c_str()
+                  #else
+                  , r->name()
+                  #endif
+                  );
+   }
+   return n;
+}
+
+}  //namespace boost {
+
+//! Counts a copy construction of TYPE. To be placed in the body of the copy constructor.
+//!
+#define BOOST_MOVE_TRACE_COPY_CONSTRUCT(TYPE)\
+   ::boost::move_detail::move_trace_of< TYPE >::inc(::boost::move_detail::move_trace_record::copy_construct)
+//
+
+//! Counts a move construction of TYPE. To be placed in the body of the move constructor.
+//!
+#define BOOST_MOVE_TRACE_MOVE_CONSTRUCT(TYPE)\
+   ::boost::move_detail::move_trace_of< TYPE >::inc(::boost::move_detail::move_trace_record::move_construct)
+//
+
+//! Counts a copy assignment of TYPE. To be placed at the beginning of the body of the copy assignment.
+//! Copy assignments from non-const lvalues already counted by <tt>BOOST_COPYABLE_AND_MOVABLE</tt>
+//! are not counted again.
+#define BOOST_MOVE_TRACE_COPY_ASSIGN(TYPE)\
+   ::boost::move_detail::move_trace_of< TYPE >::copy_assign_hook()
+//
+
+//! Counts a move assignment of TYPE. To be placed in the body of the move assignment.
+//!
+#define BOOST_MOVE_TRACE_MOVE_ASSIGN(TYPE)\
+   ::boost::move_detail::move_trace_of< TYPE >::inc(::boost::move_detail::move_trace_record::move_assign)
+//
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+#define BOOST_MOVE_TRACE_RVALUE_CAST(TYPE)\
+   ::boost::move_detail::move_trace_rvalue_cast< TYPE >()
+//
+
+#define BOOST_MOVE_TRACE_MOVE(TYPE)\
+   ::boost::move_detail::move_trace_move< TYPE >()
+//
+
+#define BOOST_MOVE_TRACE_LVALUE_COPY_ASSIGN(TYPE)\
+   ::boost::move_detail::move_trace_lvalue_copy_assign< TYPE > boost_move_trace_lvalue_copy_assign
+//
+#endif
+
+#else    //#if defined(BOOST_MOVE_ENABLE_TRACE) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+#define BOOST_MOVE_TRACE_COPY_CONSTRUCT(TYPE) ((void)0)
+#define BOOST_MOVE_TRACE_MOVE_CONSTRUCT(TYPE) ((void)0)
+#define BOOST_MOVE_TRACE_COPY_ASSIGN(TYPE)    ((void)0)
+#define BOOST_MOVE_TRACE_MOVE_ASSIGN(TYPE)    ((void)0)
+#define BOOST_MOVE_TRACE_RVALUE_CAST(TYPE)    ((void)0)
+#define BOOST_MOVE_TRACE_MOVE(TYPE)           ((void)0)
+#define BOOST_MOVE_TRACE_LVALUE_COPY_ASSIGN(TYPE) ((void)0)
+
+#endif   //#if defined(BOOST_MOVE_ENABLE_TRACE) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif //#ifndef BOOST_MOVE_TRACE_HPP
@@ -0,0 +1,262 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_TRAILING_DELETE_HPP_INCLUDED
+#define BOOST_MOVE_TRAILING_DELETE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/detail/memory_utils.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>   //For std::size_t
+#include <new>       //For placement new, std::bad_alloc
+
+//!\file
+//! Describes <tt>trailing_delete</tt> and the <tt>make_unique_with_trailing</tt> factories,
+//! which create an object followed by an array in a single allocation.
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace move_upd {
+
+//////////////////////////////////////
+//         trailing_layout
+//////////////////////////////////////
+
+//The header is placed at the beginning of the block and the trailing
+//elements at the first suitably aligned offset after the header
+template<class T, class U>
+struct trailing_layout
+{
+   BOOST_STATIC_ASSERT(( alignment_of<T>::value <= alignment_of<max_align_t>::value ));
+   BOOST_STATIC_ASSERT(( alignment_of<U>::value <= alignment_of<max_align_t>::value ));
+
+   static const std::size_t offset =
+      (sizeof(T) + alignment_of<U>::value - 1u)/alignment_of<U>::value*alignment_of<U>::value;
+
+   static std::size_t size(std::size_t n)
+   {
+      std::size_t const trailing = array_allocation_size(n, sizeof(U));
+      if(trailing > std::size_t(-1) - offset){
+         ::boost::throw_exception(std::bad_alloc());
+      }
+      return offset + trailing;
+   }
+
+   static U *trailing(T *p) BOOST_NOEXCEPT
+   {  return reinterpret_cast<U*>(reinterpret_cast<char*>(p) + offset);  }
+
+   static void destroy_trailing(U *u, std::size_t n) BOOST_NOEXCEPT
+   {
+      while(n){
+         u[--n].~U();
+      }
+   }
+};
+
+//////////////////////////////////////
+//     trailing_construct_guard
+//////////////////////////////////////
+
+//Owns the block while the header and the trailing elements are being
+//constructed, undoing the partial construction if an exception is thrown
+template<class T, class U>
+class trailing_construct_guard
+{
+   typedef trailing_layout<T, U> layout_t;
+
+   trailing_construct_guard(const trailing_construct_guard &);
+   trailing_construct_guard &operator=(const trailing_construct_guard &);
+
+   public:
+   explicit trailing_construct_guard(std::size_t n)
+      : m_p(raw_allocate(layout_t::size(n))), m_n(n), m_constructed(0), m_header(false)
+   {}
+
+   ~trailing_construct_guard()
+   {
+      if(m_p){
+         if(m_header){
+            layout_t::destroy_trailing(layout_t::trailing(static_cast<T*>(m_p)), m_constructed);
+            static_cast<T*>(m_p)->~T();
+         }
+         raw_deallocate(m_p, layout_t::size(m_n));
+      }
+   }
+
+   void *header_storage() const
+   {  return m_p;  }
+
+   void header_constructed()
+   {  m_header = true;  }
+
+   void construct_trailing(bool value_init)
+   {
+      U *const u = layout_t::trailing(static_cast<T*>(m_p));
+      for(; m_constructed != m_n; ++m_constructed){
+         if(value_init)
+            ::new(static_cast<void*>(u + m_constructed)) U();
+         else
+            ::new(static_cast<void*>(u + m_constructed)) U;
+      }
+   }
+
+   T *release()
+   {
+      T *const p = static_cast<T*>(m_p);
+      m_p = 0;
+      return p;
+   }
+
+   private:
+   void *m_p;
+   std::size_t m_n;
+   std::size_t m_constructed;
+   bool m_header;
+};
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>trailing_delete</tt> is the deleter of the objects created by
+//!<tt>make_unique_with_trailing<T, U></tt>: a T header followed in the same allocation by
+//!an array of U elements. It stores the number of elements, destroys them in reverse order,
+//!destroys the header and frees the block, passing its size to the deallocation function
+//!if C++14 sized deallocation is available.
+//!
+//!Only pointers obtained from <tt>make_unique_with_trailing<T, U></tt> can be deleted.
+//!
+//! \tparam T The type of the header. Must be a complete type.
+//! \tparam U The type of the trailing elements. Must be a complete type.
+template <class T, class U>
+struct trailing_delete
+{
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   typedef bmupd::trailing_layout<T, U> layout_t;
+   #endif
+
+   public:
+   //! <b>Effects</b>: Constructs a deleter for a block with n trailing elements.
+   //!
+   explicit trailing_delete(std::size_t n = 0u) BOOST_NOEXCEPT
+      : m_size(n)
+   {}
+
+   //! <b>Returns</b>: The number of trailing elements.
+   //!
+   std::size_t size() const BOOST_NOEXCEPT
+   {  return m_size;  }
+
+   //! <b>Returns</b>: A pointer to the first trailing element of the block whose header is p.
+   //!
+   static U *trailing(T *p) BOOST_NOEXCEPT
+   {  return layout_t::trailing(p);  }
+
+   //! <b>Effects</b>: If p is not null, destroys the trailing elements in reverse order,
+   //!   destroys the header and frees the block.
+   void operator()(T *p) const BOOST_NOEXCEPT
+   {
+      if(p){
+         layout_t::destroy_trailing(layout_t::trailing(p), m_size);
+         p->~T();
+         bmupd::raw_deallocate(p, layout_t::offset + m_size*sizeof(U));
+      }
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   std::size_t m_size;
+   #endif
+};
+
+//! <b>Returns</b>: A pointer to the first trailing element of the block owned by p.
+//!
+template<class T, class U>
+inline U *trailing_data(const unique_ptr<T, trailing_delete<T, U> > &p) BOOST_NOEXCEPT
+{  return p ? trailing_delete<T, U>::trailing(p.get()) : static_cast<U*>(0);  }
+
+#if defined(BOOST_MOVE_DOXYGEN_INVOKED) || !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+//! <b>Effects</b>: Allocates a single block for a T and n elements of type U. Constructs
+//!   the header with <tt>T(std::forward<Args>(args)...)</tt> and value-initializes the elements.
+//!   If an exception is thrown, the constructed subobjects are destroyed and the block is freed.
+//!
+//! <b>Returns</b>: A unique_ptr owning the header whose deleter stores n.
+//!
+//! <b>Throws</b>: std::bad_alloc if the size of the block overflows std::size_t or the allocation fails,
+//!   or any exception thrown by the constructors.
+template<class T, class U, class... Args>
+inline unique_ptr<T, trailing_delete<T, U> >
+   make_unique_with_trailing(std::size_t n, BOOST_FWD_REF(Args)... args)
+{
+   bmupd::trailing_construct_guard<T, U> g(n);
+   ::new(g.header_storage()) T(::boost::forward<Args>(args)...);
+   g.header_constructed();
+   g.construct_trailing(true);
+   return unique_ptr<T, trailing_delete<T, U> >(g.release(), trailing_delete<T, U>(n));
+}
+
+//! <b>Effects</b>: Same as <tt>make_unique_with_trailing</tt>, but the elements are default-initialized.
+//!
+template<class T, class U, class... Args>
+inline unique_ptr<T, trailing_delete<T, U> >
+   make_unique_with_trailing_definit(std::size_t n, BOOST_FWD_REF(Args)... args)
+{
+   bmupd::trailing_construct_guard<T, U> g(n);
+   ::new(g.header_storage()) T(::boost::forward<Args>(args)...);
+   g.header_constructed();
+   g.construct_trailing(false);
+   return unique_ptr<T, trailing_delete<T, U> >(g.release(), trailing_delete<T, U>(n));
+}
+
+#else
+
+   #define BOOST_MOVE_MAKE_UNIQUE_TRAILING_DEF(NAME, VALUE_INIT, N) \
+   template<class T, class U BOOST_PP_ENUM_TRAILING_PARAMS(N, class P) > \
+   inline unique_ptr<T, trailing_delete<T, U> > \
+      NAME(std::size_t n BOOST_PP_ENUM_TRAILING(N, BOOST_MOVE_PP_PARAM_LIST, _)) \
+   { \
+      bmupd::trailing_construct_guard<T, U> g(n); \
+      ::new(g.header_storage()) T(BOOST_PP_ENUM(N, BOOST_MOVE_PP_PARAM_FORWARD, _)); \
+      g.header_constructed(); \
+      g.construct_trailing(VALUE_INIT); \
+      return unique_ptr<T, trailing_delete<T, U> >(g.release(), trailing_delete<T, U>(n)); \
+   } \
+   //!
+
+   #define BOOST_PP_LOCAL_MACRO(n) \
+   BOOST_MOVE_MAKE_UNIQUE_TRAILING_DEF(make_unique_with_trailing, true, n) \
+   BOOST_MOVE_MAKE_UNIQUE_TRAILING_DEF(make_unique_with_trailing_definit, false, n) \
+   //!
+
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+   #undef BOOST_MOVE_MAKE_UNIQUE_TRAILING_DEF
+
+#endif
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_TRAILING_DELETE_HPP_INCLUDED
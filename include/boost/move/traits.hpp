@@ -16,9 +16,16 @@
 
 #include <boost/move/detail/config_begin.hpp>
 #include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/has_trivial_constructor.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_enum.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_empty.hpp>
 #include <boost/type_traits/is_nothrow_move_constructible.hpp>
 #include <boost/type_traits/is_nothrow_move_assignable.hpp>
 #include <boost/type_traits/is_copy_constructible.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 #include <boost/move/detail/meta_utils.hpp>
 
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
@@ -27,29 +34,101 @@
 
 namespace boost {
 
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace move_detail {
+
+//Defines NAME<T>::value, true if T declares the marker typedef TYPEDEF naming T
+//itself, so that markers declared in base classes are not inherited.
+#define BOOST_MOVE_TRAITS_DEFINE_MARKER_DETECTOR(NAME, TYPEDEF)\
+   template <class T>\
+   class NAME##_typedef\
+   {\
+      typedef char true_t;\
+      class false_t { char dummy[2]; };\
+      template<class U> static false_t dispatch(...);\
+      template<class U> static true_t  dispatch(typename U::TYPEDEF*);\
+      public:\
+      static const bool value = sizeof(dispatch<T>(0)) == sizeof(true_t);\
+   };\
+   \
+   template <class T, bool = NAME##_typedef<T>::value>\
+   struct NAME\
+   {\
+      static const bool value = false;\
+   };\
+   \
+   template <class T>\
+   struct NAME<T, true>\
+   {\
+      static const bool value = is_same\
+         < typename boost::remove_cv<typename T::TYPEDEF>::type\
+         , typename boost::remove_cv<T>::type>::value;\
+   };\
+//
+
+//BOOST_MOVABLE_BUT_NOT_COPYABLE_NOTHROW or BOOST_COPYABLE_AND_MOVABLE_NOTHROW
+BOOST_MOVE_TRAITS_DEFINE_MARKER_DETECTOR(has_nothrow_move_marker, boost_move_nothrow_move_t)
+//BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE
+BOOST_MOVE_TRAITS_DEFINE_MARKER_DETECTOR(has_trivial_destructor_after_move_marker, boost_move_trivial_destructor_after_move_t)
+//BOOST_MOVE_ZERO_INITIALIZABLE
+BOOST_MOVE_TRAITS_DEFINE_MARKER_DETECTOR(is_zero_initializable_marker, boost_move_zero_initializable_t)
+
+#undef BOOST_MOVE_TRAITS_DEFINE_MARKER_DETECTOR
+
+}  //move_detail {
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
 //! If this trait yields to true
 //! (<i>has_trivial_destructor_after_move &lt;T&gt;::value == true</i>)
 //! means that if T is used as argument of a move construction/assignment,
 //! there is no need to call T's destructor.
 //! This optimization tipically is used to improve containers' performance.
 //!
-//! By default this trait is true if the type has trivial destructor,
-//! every class should specialize this trait if it wants to improve performance
+//! By default this trait is true if the type has trivial destructor or
+//! if it was marked with BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE.
+//! Every other class should specialize this trait if it wants to improve performance
 //! when inserted in containers.
 template <class T>
 struct has_trivial_destructor_after_move
-   : ::boost::has_trivial_destructor<T>
+   : ::boost::integral_constant
+      < bool
+      , ::boost::has_trivial_destructor<T>::value ||
+        ::boost::move_detail::has_trivial_destructor_after_move_marker<T>::value
+      >
+{};
+
+//! If this trait yields to true an object of type T whose bytes are all zero is a valid object,
+//! equivalent to a value-initialized T, so arrays of T can be value-initialized with
+//! <tt>std::calloc</tt> or <tt>std::memset</tt> instead of calling constructors.
+//!
+//! By default this trait is true for arithmetic, enumeration and pointer types (but not pointers
+//! to members), for empty classes with trivial default constructor and for classes marked with
+//! BOOST_MOVE_ZERO_INITIALIZABLE. Other classes can specialize this trait.
+template <class T>
+struct is_zero_initializable
+   : ::boost::integral_constant
+      < bool
+      , ::boost::is_arithmetic<T>::value ||
+        ::boost::is_enum<T>::value ||
+        ::boost::is_pointer<T>::value ||
+        (::boost::is_empty<T>::value && ::boost::has_trivial_constructor<T>::value) ||
+        ::boost::move_detail::is_zero_initializable_marker<T>::value
+      >
 {};
 
 //! By default this traits returns
-//! <pre>boost::is_nothrow_move_constructible<T>::value && boost::is_nothrow_move_assignable<T>::value </pre>.
+//! <pre>boost::is_nothrow_move_constructible<T>::value && boost::is_nothrow_move_assignable<T>::value </pre>,
+//! or true if T was marked with BOOST_MOVABLE_BUT_NOT_COPYABLE_NOTHROW or BOOST_COPYABLE_AND_MOVABLE_NOTHROW.
 //! Classes with non-throwing move constructor
-//! and assignment can specialize this trait to obtain some performance improvements.
+//! and assignment can use those macros or specialize this trait to obtain some performance improvements.
 template <class T>
 struct has_nothrow_move
 {
-   static const bool value = boost::is_nothrow_move_constructible<T>::value &&
-                             boost::is_nothrow_move_assignable<T>::value;
+   static const bool value = (boost::is_nothrow_move_constructible<T>::value &&
+                              boost::is_nothrow_move_assignable<T>::value) ||
+                             ::boost::move_detail::has_nothrow_move_marker<T>::value;
 };
 
 namespace move_detail {
@@ -0,0 +1,393 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_UNIQUE_ARRAY_HPP_INCLUDED
+#define BOOST_MOVE_UNIQUE_ARRAY_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/detail/memory_utils.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/move/traits.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>   //For std::size_t
+
+//!\file
+//! Describes <tt>sized_array_delete</tt>, a deleter for <tt>unique_ptr<T[]></tt> that remembers
+//! the number of elements of the array, the <tt>unique_array</tt> owner built on top of it
+//! and the <tt>make_unique_array</tt> factories.
+//!
+//! Unlike <tt>make_unique<T[]>(n)</tt>, the element count is not lost: it's available
+//! through <tt>size()</tt> and it's passed to the sized deallocation function
+//! (<tt>operator delete[](void*, std::size_t)</tt>) when the compiler supports it,
+//! so that the memory allocator does not need to look up the size of the block.
+//!
+//! Arrays of at least <tt>BOOST_MOVE_CALLOC_THRESHOLD</tt> bytes whose elements are zero-initializable
+//! (<tt>is_zero_initializable<T>::value</tt> is true) are instead allocated with <tt>std::calloc</tt>
+//! (<tt>std::malloc</tt> if default-initialized) and freed with <tt>std::free</tt>, so that value-initializing
+//! a big array maps zero-filled pages instead of writing every element.
+
+//! Minimum size in bytes of the arrays of zero-initializable elements that <tt>make_unique_array</tt>
+//! allocates with <tt>std::calloc</tt>. Smaller blocks are usually recycled by the allocator, so they
+//! would be cleared anyway, and benefit more from sized deallocation.
+#ifndef BOOST_MOVE_CALLOC_THRESHOLD
+   #define BOOST_MOVE_CALLOC_THRESHOLD 131072u
+#endif
+
+namespace boost{
+
+#if !defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+namespace move_upd {
+
+//Big arrays of zero-initializable elements are allocated with std::malloc/std::calloc,
+//so that value-initializing them maps zero pages instead of writing every element.
+//Small arrays (and over-aligned elements) use operator new[] and sized deallocation.
+//The decision only depends on T and n so the deleter can repeat it.
+template<class T>
+inline bool unique_array_c_allocated(std::size_t n) BOOST_NOEXCEPT
+{
+   return ::boost::is_zero_initializable<T>::value &&
+      alignment_of<T>::value <= alignment_of<max_align_t>::value &&
+      n >= (BOOST_MOVE_CALLOC_THRESHOLD)/sizeof(T);
+}
+
+template<class T>
+void *unique_array_allocate(std::size_t n, bool zeroed)
+{
+   const std::size_t bytes = ::boost::move_upd::array_allocation_size(n, sizeof(T));
+   return unique_array_c_allocated<T>(n)
+      ? ::boost::move_upd::raw_c_allocate(bytes, zeroed)
+      : ::boost::move_upd::raw_array_allocate(bytes);
+}
+
+template<class T>
+void unique_array_deallocate(T *p, std::size_t n) BOOST_NOEXCEPT
+{
+   void *const mem = const_cast<void*>(static_cast<const volatile void*>(p));
+   if(unique_array_c_allocated<T>(n)){
+      ::boost::move_upd::raw_c_deallocate(mem);
+   }
+   else{
+      ::boost::move_upd::raw_array_deallocate(mem, n*sizeof(T));
+   }
+}
+
+template<class T>
+struct unique_array_construct_guard
+{
+   unique_array_construct_guard(T *p, std::size_t n)
+      : m_p(p), m_n(n), m_constructed(0)
+   {}
+
+   ~unique_array_construct_guard()
+   {
+      if(m_p){
+         while(m_constructed){
+            m_p[--m_constructed].~T();
+         }
+         ::boost::move_upd::unique_array_deallocate(m_p, m_n);
+      }
+   }
+
+   T* release()
+   {  T *const p = m_p;  m_p = 0;  return p;  }
+
+   T *m_p;
+   std::size_t m_n;
+   std::size_t m_constructed;
+};
+
+template<class T, bool ValueInit>
+T* unique_array_create(std::size_t n)
+{
+   //Zeroed storage already holds value-initialized elements
+   const bool zeroed = ValueInit && unique_array_c_allocated<T>(n);
+   void *const mem = ::boost::move_upd::unique_array_allocate<T>(n, zeroed);
+   unique_array_construct_guard<T> g(static_cast<T*>(mem), n);
+   if(zeroed){
+      g.m_constructed = n;
+   }
+   for(; g.m_constructed != n; ++g.m_constructed){
+      void *const addr = static_cast<void*>(g.m_p + g.m_constructed);
+      ValueInit ? ::new(addr) T() : ::new(addr) T;
+   }
+   return g.release();
+}
+
+}  //namespace move_upd {
+
+#endif   //#if !defined(BOOST_MOVE_DOXYGEN_INVOKED)
+
+namespace movelib {
+
+//!The class template <tt>sized_array_delete</tt> is a deleter for <tt>unique_ptr<T[]></tt>
+//!that stores the number of elements of the owned array. It destroys the elements
+//!in reverse order of construction and frees the storage passing its size to the
+//!deallocation function, if sized deallocation is supported by the compiler.
+//!
+//!The storage must have been obtained through <tt>make_unique_array</tt> or
+//!<tt>make_unique_array_definit</tt>.
+//!
+//! \tparam T The element type of the array.
+template <class T>
+class sized_array_delete
+{
+   public:
+   //! <b>Effects</b>: Constructs a deleter for an empty array.
+   //!
+   //! <b>Postcondition</b>: <tt>size() == 0</tt>.
+   sized_array_delete() BOOST_NOEXCEPT
+      : m_size(0)
+   {}
+
+   //! <b>Effects</b>: Constructs a deleter for an array of n elements.
+   //!
+   //! <b>Postcondition</b>: <tt>size() == n</tt>.
+   explicit sized_array_delete(std::size_t n) BOOST_NOEXCEPT
+      : m_size(n)
+   {}
+
+   //! <b>Returns</b>: The number of elements of the array this deleter will destroy.
+   //!
+   std::size_t size() const BOOST_NOEXCEPT
+   {  return m_size;  }
+
+   //! <b>Effects</b>: Destroys the size() elements pointed by p in reverse order
+   //!   and deallocates the storage.
+   void operator()(T *p) const BOOST_NOEXCEPT
+   {
+      //T must be a complete type
+      BOOST_STATIC_ASSERT(sizeof(T) > 0);
+      for(std::size_t n = m_size; n; ){
+         p[--n].~T();
+      }
+      ::boost::move_upd::unique_array_deallocate(p, m_size);
+   }
+
+   private:
+   std::size_t m_size;
+};
+
+//!A <tt>unique_array</tt> is a move-only owner of a dynamically allocated array
+//!that, unlike <tt>unique_ptr<T[]></tt>, knows the number of elements it owns.
+//!
+//!It's implemented as a <tt>unique_ptr<T[], sized_array_delete<T> ></tt> so it occupies
+//!two words and uses sized deallocation when destroying the array.
+//!
+//!Like <tt>unique_ptr</tt>, constness of the owner is shallow: a const <tt>unique_array</tt>
+//!still offers mutable access to the elements.
+//!
+//! \tparam T The element type of the array.
+template <class T>
+class unique_array
+{
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   public:
+   unique_array(const unique_array&) = delete;
+   unique_array& operator=(const unique_array&) = delete;
+   private:
+   #else
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(unique_array)
+   BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(unique_array)
+   BOOST_MOVE_ZERO_INITIALIZABLE(unique_array)
+   #endif
+
+   public:
+   typedef T                        element_type;
+   typedef T                        value_type;
+   typedef T*                       pointer;
+   typedef T&                       reference;
+   typedef T*                       iterator;
+   typedef std::size_t              size_type;
+   typedef sized_array_delete<T>    deleter_type;
+   typedef unique_ptr<T[], deleter_type> unique_ptr_type;
+
+   //! <b>Effects</b>: Constructs an empty unique_array.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr && size() == 0</tt>.
+   unique_array() BOOST_NOEXCEPT
+      : m_ptr()
+   {}
+
+   //! <b>Effects</b>: Same as <tt>unique_array()</tt> (default constructor).
+   //!
+   unique_array(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+      : m_ptr()
+   {}
+
+   //! <b>Requires</b>: p was obtained from <tt>make_unique_array<T></tt> or <tt>make_unique_array_definit<T></tt>
+   //!   and n is the number of elements of that array.
+   //!
+   //! <b>Effects</b>: Takes ownership of the n elements pointed by p.
+   unique_array(pointer p, size_type n) BOOST_NOEXCEPT
+      : m_ptr(p, deleter_type(n))
+   {}
+
+   //! <b>Effects</b>: Transfers ownership from the unique_ptr u.
+   //!
+   explicit unique_array(BOOST_RV_REF(unique_ptr_type) u) BOOST_NOEXCEPT
+      : m_ptr(::boost::move(u))
+   {}
+
+   //! <b>Effects</b>: Constructs a unique_array by transferring ownership from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr && x.size() == 0</tt>.
+   unique_array(BOOST_RV_REF(unique_array) x) BOOST_NOEXCEPT
+      : m_ptr(::boost::move(x.m_ptr))
+   {  x.m_ptr.get_deleter() = deleter_type();  }
+
+   //! <b>Effects</b>: Destroys the owned elements, if any, and transfers ownership from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr && x.size() == 0</tt>.
+   unique_array& operator=(BOOST_RV_REF(unique_array) x) BOOST_NOEXCEPT
+   {
+      m_ptr = ::boost::move(x.m_ptr);
+      x.m_ptr.get_deleter() = deleter_type();
+      return *this;
+   }
+
+   //! <b>Effects</b>: <tt>reset()</tt>.
+   //!
+   unique_array& operator=(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+   {  this->reset(); return *this;  }
+
+   //! <b>Returns</b>: A pointer to the first element or nullptr if empty.
+   //!
+   pointer get() const BOOST_NOEXCEPT
+   {  return m_ptr.get();  }
+
+   //! <b>Returns</b>: <tt>get()</tt>.
+   //!
+   pointer data() const BOOST_NOEXCEPT
+   {  return m_ptr.get();  }
+
+   //! <b>Returns</b>: The number of owned elements.
+   //!
+   size_type size() const BOOST_NOEXCEPT
+   {  return m_ptr.get_deleter().size();  }
+
+   //! <b>Returns</b>: <tt>size() == 0</tt>.
+   //!
+   bool empty() const BOOST_NOEXCEPT
+   {  return !this->size();  }
+
+   //! <b>Returns</b>: <tt>get()</tt>.
+   //!
+   iterator begin() const BOOST_NOEXCEPT
+   {  return m_ptr.get();  }
+
+   //! <b>Returns</b>: <tt>get() + size()</tt>.
+   //!
+   iterator end() const BOOST_NOEXCEPT
+   {  return m_ptr.get() + this->size();  }
+
+   //! <b>Requires</b>: <tt>i < size()</tt>.
+   //!
+   //! <b>Returns</b>: <tt>get()[i]</tt>.
+   reference operator[](size_type i) const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(i < this->size());
+      return m_ptr[i];
+   }
+
+   //! <b>Returns</b>: A reference to the stored deleter.
+   //!
+   const deleter_type &get_deleter() const BOOST_NOEXCEPT
+   {  return m_ptr.get_deleter();  }
+
+   #ifdef BOOST_MOVE_DOXYGEN_INVOKED
+   //! <b>Returns</b>: Returns: get() != nullptr.
+   //!
+   explicit operator bool
+   #else
+   operator bmupd::explicit_bool_arg
+   #endif
+      ()const BOOST_NOEXCEPT
+   {
+      return m_ptr.get()
+         ? &bmupd::bool_conversion::for_bool
+         : bmupd::explicit_bool_arg(0);
+   }
+
+   //! <b>Effects</b>: Transfers ownership of the elements and the deleter to the returned unique_ptr.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr && size() == 0</tt>.
+   unique_ptr_type release_unique_ptr() BOOST_NOEXCEPT
+   {
+      unique_ptr_type r(::boost::move(m_ptr));
+      m_ptr.get_deleter() = deleter_type();
+      return ::boost::move(r);
+   }
+
+   //! <b>Effects</b>: Destroys the owned elements, if any.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr && size() == 0</tt>.
+   void reset() BOOST_NOEXCEPT
+   {
+      m_ptr.reset();
+      m_ptr.get_deleter() = deleter_type();
+   }
+
+   //! <b>Requires</b>: p was obtained from <tt>make_unique_array<T></tt> or <tt>make_unique_array_definit<T></tt>
+   //!   and n is the number of elements of that array.
+   //!
+   //! <b>Effects</b>: Destroys the owned elements, if any, and takes ownership of the n elements pointed by p.
+   void reset(pointer p, size_type n) BOOST_NOEXCEPT
+   {
+      unique_array tmp(p, n);
+      this->swap(tmp);
+   }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x.
+   //!
+   void swap(unique_array &x) BOOST_NOEXCEPT
+   {  m_ptr.swap(x.m_ptr);  }
+
+   private:
+   unique_ptr_type m_ptr;
+};
+
+//! <b>Effects</b>: Calls <tt>x.swap(y)</tt>.
+//!
+template <class T>
+inline void swap(unique_array<T> &x, unique_array<T> &y) BOOST_NOEXCEPT
+{  x.swap(y); }
+
+//! <b>Effects</b>: Allocates storage for n elements of type T and value-initializes them.
+//!   If the construction of an element throws, already constructed elements are destroyed
+//!   and the storage is deallocated.
+//!
+//!   If <tt>is_zero_initializable<T>::value</tt> is true and the array is not smaller than
+//!   <tt>BOOST_MOVE_CALLOC_THRESHOLD</tt> bytes, the storage is obtained with <tt>std::calloc</tt>
+//!   and no constructor is called.
+//!
+//! <b>Returns</b>: A <tt>unique_array<T></tt> owning the new elements.
+template <class T>
+inline unique_array<T> make_unique_array(std::size_t n)
+{  return unique_array<T>(::boost::move_upd::unique_array_create<T, true>(n), n);  }
+
+//! <b>Effects</b>: Allocates storage for n elements of type T and default-initializes them.
+//!   If the construction of an element throws, already constructed elements are destroyed
+//!   and the storage is deallocated.
+//!
+//! <b>Returns</b>: A <tt>unique_array<T></tt> owning the new elements.
+template <class T>
+inline unique_array<T> make_unique_array_definit(std::size_t n)
+{  return unique_array<T>(::boost::move_upd::unique_array_create<T, false>(n), n);  }
+
+}  //namespace movelib {
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_UNIQUE_ARRAY_HPP_INCLUDED
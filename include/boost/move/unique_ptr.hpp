@@ -20,6 +20,7 @@
 #include <boost/assert.hpp>
 
 #include <cstddef>   //For std::nullptr_t and std::size_t
+#include <functional>   //For std::less
 
 //!\file
 //! Describes the smart pointer unique_ptr, a drop-in replacement for std::unique_ptr,
@@ -28,10 +29,11 @@
 //! Main differences from std::unique_ptr to avoid heavy dependencies,
 //! specially in C++03 compilers:
 //!   - <tt>operator < </tt> uses pointer <tt>operator < </tt>instead of <tt>std::less<common_type></tt>. 
-//!      This avoids dependencies on <tt>std::common_type</tt> and <tt>std::less</tt>
-//!      (<tt><type_traits>/<functional></tt> headers. In C++03 this avoid pulling Boost.Typeof and other
+//!      This avoids a dependency on <tt>std::common_type</tt>
+//!      (<tt><type_traits></tt> header). In C++03 this avoid pulling Boost.Typeof and other
 //!      cascading dependencies. As in all Boost platforms <tt>operator <</tt> on raw pointers and
 //!      other smart pointers provides strict weak ordering in practice this should not be a problem for users.
+//!      Containers that need the guaranteed total order can use <tt>unique_ptr_less</tt>, which uses <tt>std::less</tt>.
 //!   - assignable from literal 0 for compilers without nullptr
 //!   - <tt>unique_ptr<T[]></tt> is constructible and assignable from <tt>unique_ptr<U[]></tt> if
 //!      cv-less T and cv-less U are the same type and T is more CV qualified than U.
@@ -73,10 +75,34 @@ struct deleter_types
    #endif
 };
 
+//The default deleter is neither a reference nor noncopyable
+template <class T>
+struct deleter_types< ::boost::movelib::default_delete<T> >
+{
+   typedef ::boost::movelib::default_delete<T>                    D;
+   typedef D &                                                    del_ref;
+   typedef const D &                                              del_cref;
+   typedef const D &                                              deleter_arg_type1;
+   typedef BOOST_RV_REF(D)                                        deleter_arg_type2;
+};
+
+//Deleters that can't be stored as an empty base of unique_ptr_data
+template <class D>
+struct deleter_is_member
+{
+   static const bool value = bmupmu::is_unary_function<D>::value || bmupmu::is_reference<D>::value;
+};
+
+template <class T>
+struct deleter_is_member< ::boost::movelib::default_delete<T> >
+{
+   static const bool value = false;
+};
+
 ////////////////////////////////////////////
 //          unique_ptr_data
 ////////////////////////////////////////////
-template <class P, class D, bool = bmupmu::is_unary_function<D>::value || bmupmu::is_reference<D>::value >
+template <class P, class D, bool = deleter_is_member<D>::value >
 struct unique_ptr_data
 {
    typedef typename deleter_types<D>::deleter_arg_type1  deleter_arg_type1;
@@ -203,6 +229,14 @@ struct enable_up_ptr
       < bmupmu::is_array<T>::value, FromPointer, ThisPointer>::value, Type>
 {};
 
+//Passing the pointer type itself is by far the most common case,
+//avoid instantiating the convertibility checks
+template<class T, class Pointer, class Type>
+struct enable_up_ptr<T, Pointer, Pointer, Type>
+{
+   typedef Type type;
+};
+
 ////////////////////////////////////////
 ////     enable_up_moveconv_assign
 ////////////////////////////////////////
@@ -847,7 +881,122 @@ template <class T, class D>
 inline bool operator>=(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type), const unique_ptr<T, D> &x)
 {  return !(bmupd::nullptr_type() < x);  }
 
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
 }  //namespace movelib {
+
+namespace move_upd {
+
+//Obtains the raw pointer of the keys accepted by the transparent function objects
+template <class T>
+struct unique_ptr_key
+{
+   typedef const typename bmupmu::remove_extent<T>::type *type;
+
+   static type get(type p) BOOST_NOEXCEPT
+   {  return p;  }
+
+   template <class D>
+   static type get(const ::boost::movelib::unique_ptr<T, D> &p) BOOST_NOEXCEPT
+   {  return p.get();  }
+
+   static type get(nullptr_type) BOOST_NOEXCEPT
+   {  return type();  }
+};
+
+}  //namespace move_upd {
+
+namespace movelib {
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+//!Transparent function object that orders <tt>unique_ptr<T, D></tt> objects, for any D,
+//!pointers convertible to <tt>const remove_extent_t<T>*</tt> and nullptr by their pointer value.
+//!
+//!As it defines <tt>is_transparent</tt>, associative containers of <tt>unique_ptr<T, D></tt> can be
+//!searched with a raw pointer, without building (and later releasing) a temporary owner.
+//!
+//! <b>Remarks</b>: Only usable with deleters whose <tt>pointer</tt> type is <tt>remove_extent_t<T>*</tt>.
+template <class T>
+struct unique_ptr_less
+{
+   typedef void is_transparent;
+
+   //! <b>Returns</b>: <tt>std::less<const remove_extent_t<T>*>()(p(x), p(y))</tt>, where <tt>p(a)</tt> is
+   //!   <tt>a.get()</tt> for unique_ptr objects, a null pointer for nullptr and a otherwise.
+   //!   Unlike the built-in <tt>operator <</tt>, this is a total order for unrelated pointers.
+   template <class U, class V>
+   bool operator()(const U &x, const V &y) const BOOST_NOEXCEPT
+   {
+      typedef typename bmupd::unique_ptr_key<T>::type key_type;
+      return std::less<key_type>()(bmupd::unique_ptr_key<T>::get(x), bmupd::unique_ptr_key<T>::get(y));
+   }
+};
+
+//!Transparent function object that compares <tt>unique_ptr<T, D></tt> objects, for any D,
+//!pointers convertible to <tt>const remove_extent_t<T>*</tt> and nullptr by their pointer value.
+//!
+//! <b>Remarks</b>: Only usable with deleters whose <tt>pointer</tt> type is <tt>remove_extent_t<T>*</tt>.
+template <class T>
+struct unique_ptr_equal_to
+{
+   typedef void is_transparent;
+
+   //! <b>Returns</b>: <tt>p(x) == p(y)</tt>, where <tt>p(a)</tt> is <tt>a.get()</tt> for unique_ptr objects,
+   //!   a null pointer for nullptr and a otherwise.
+   template <class U, class V>
+   bool operator()(const U &x, const V &y) const BOOST_NOEXCEPT
+   {  return bmupd::unique_ptr_key<T>::get(x) == bmupd::unique_ptr_key<T>::get(y);  }
+};
+
+//!Transparent hash function object for <tt>unique_ptr<T, D></tt> objects, for any D,
+//!pointers convertible to <tt>const remove_extent_t<T>*</tt> and nullptr.
+//!Equal pointer values produce the same hash, so that together with <tt>unique_ptr_equal_to<T></tt>
+//!unordered containers of <tt>unique_ptr<T, D></tt> can be searched with a raw pointer.
+//!
+//! <b>Remarks</b>: Only usable with deleters whose <tt>pointer</tt> type is <tt>remove_extent_t<T>*</tt>.
+template <class T>
+struct unique_ptr_hash
+{
+   typedef void is_transparent;
+
+   //! <b>Returns</b>: The hash of <tt>p(x)</tt>, where <tt>p(a)</tt> is <tt>a.get()</tt> for unique_ptr objects,
+   //!   a null pointer for nullptr and a otherwise.
+   template <class U>
+   std::size_t operator()(const U &x) const BOOST_NOEXCEPT
+   {
+      //Same mixing as boost::hash for pointers, the low bits are zero because of alignment
+      std::size_t const v = reinterpret_cast<std::size_t>(bmupd::unique_ptr_key<T>::get(x));
+      return v + (v >> 3);
+   }
+};
+
+}  //namespace movelib {
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+template <class T>
+struct has_trivial_destructor_after_move;
+
+template <class T>
+struct is_zero_initializable;
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+//!A moved-from <tt>unique_ptr</tt> holds a null pointer, so only the destructor of its deleter remains.
+//!
+template <class T, class D>
+struct has_trivial_destructor_after_move< ::boost::movelib::unique_ptr<T, D> >
+   : has_trivial_destructor_after_move<D>
+{};
+
+//!A value-initialized <tt>unique_ptr</tt> holds a null pointer and a value-initialized deleter,
+//!so it's zero-initializable if both the pointer and the deleter are.
+template <class T, class D>
+struct is_zero_initializable< ::boost::movelib::unique_ptr<T, D> >
+{
+   static const bool value = is_zero_initializable<typename ::boost::movelib::unique_ptr<T, D>::pointer>::value &&
+                             is_zero_initializable<D>::value;
+};
+
 }  //namespace boost{
 
 #include <boost/move/detail/config_end.hpp>
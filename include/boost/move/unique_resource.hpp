@@ -0,0 +1,351 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_UNIQUE_RESOURCE_HPP_INCLUDED
+#define BOOST_MOVE_UNIQUE_RESOURCE_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/traits.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
+
+#include <iterator>  //For std::iterator_traits
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <unistd.h>  //For close, close_range
+#include <algorithm> //For std::sort
+#include <vector>
+#endif
+
+//Linux close_range(2), declared by glibc 2.34 and later
+#if !defined(BOOST_MOVE_NO_CLOSE_RANGE) && defined(BOOST_HAS_UNISTD_H) && defined(__linux__) && \
+    defined(_GNU_SOURCE) && defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+   #define BOOST_MOVE_HAS_CLOSE_RANGE
+#endif
+
+//!\file
+//! Describes <tt>unique_resource</tt>, a move-only owner of a handle (e.g. a file descriptor)
+//! that marks the empty state with an invalid handle value, the sentinel policies
+//! <tt>value_init_sentinel</tt> and <tt>invalid_value_sentinel</tt>, and <tt>close_all</tt>,
+//! which releases a range of owners. On POSIX systems it also describes <tt>unique_fd</tt>.
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>value_init_sentinel</tt> is the default sentinel policy of <tt>unique_resource</tt>:
+//!the invalid handle is a value-initialized Handle (0 or null).
+template<class Handle>
+struct value_init_sentinel
+{
+   //! <b>Returns</b>: <tt>Handle()</tt>.
+   //!
+   static Handle invalid() BOOST_NOEXCEPT
+   {  return Handle();  }
+};
+
+//!The class template <tt>invalid_value_sentinel</tt> is a sentinel policy for <tt>unique_resource</tt>
+//!whose invalid handle is the constant Invalid, e.g. <tt>invalid_value_sentinel<int, -1></tt> for
+//!POSIX file descriptors.
+template<class Handle, Handle Invalid>
+struct invalid_value_sentinel
+{
+   //! <b>Returns</b>: Invalid.
+   //!
+   static Handle invalid() BOOST_NOEXCEPT
+   {  return Invalid;  }
+};
+
+//!The class template <tt>unique_resource</tt> is a move-only owner of a handle, which is released
+//!calling the deleter when the owner is destroyed or reset.
+//!
+//!Unlike owners that keep a separate flag, the empty state is represented by the invalid handle
+//!value defined by the sentinel policy, and a stateless deleter takes no space, so a
+//!<tt>unique_resource</tt> has the size of the handle. A moved-from owner holds the invalid handle,
+//!so <tt>has_trivial_destructor_after_move</tt> is true for owners with such deleters
+//!and containers can relocate them without calling destructors.
+//!
+//! \tparam Handle The type of the handle. Must be copyable and equality comparable.
+//! \tparam Deleter A function object or function pointer called with a valid handle to release it.
+//! \tparam Sentinel A type with a static member function <tt>invalid()</tt> that returns the invalid handle.
+template < class Handle
+         , class Deleter
+         , class Sentinel BOOST_MOVE_DOCIGN(= value_init_sentinel<Handle>) >
+class unique_resource
+{
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   public:
+   unique_resource(const unique_resource&) = delete;
+   unique_resource& operator=(const unique_resource&) = delete;
+   private:
+   #else
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(unique_resource)
+   typedef bmupd::unique_ptr_data<Handle, Deleter>             data_type;
+   typedef typename data_type::deleter_arg_type1               deleter_arg_type1;
+   data_type m_data;
+   #endif
+
+   public:
+   typedef Handle    handle_type;
+   typedef Deleter   deleter_type;
+   typedef Sentinel  sentinel_type;
+
+   //! <b>Effects</b>: Constructs an empty owner, value-initializing the deleter.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == Sentinel::invalid()</tt>.
+   unique_resource() BOOST_NOEXCEPT
+      : m_data(Sentinel::invalid())
+   {}
+
+   //! <b>Effects</b>: Takes ownership of h, value-initializing the deleter.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == h</tt>.
+   explicit unique_resource(Handle h) BOOST_NOEXCEPT
+      : m_data(h)
+   {}
+
+   //! <b>Effects</b>: Takes ownership of h, storing a copy of d.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == h</tt>.
+   unique_resource(Handle h, BOOST_MOVE_SEEDOC(deleter_arg_type1) d) BOOST_NOEXCEPT
+      : m_data(h, d)
+   {}
+
+   //! <b>Effects</b>: Transfers ownership from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == Sentinel::invalid()</tt>.
+   unique_resource(BOOST_RV_REF(unique_resource) x) BOOST_NOEXCEPT
+      : m_data(x.release(), ::boost::move(x.m_data.deleter()))
+   {}
+
+   //! <b>Effects</b>: Releases the owned handle, if any.
+   //!
+   ~unique_resource()
+   {  this->reset();  }
+
+   //! <b>Effects</b>: Releases the owned handle, if any, and transfers ownership from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == Sentinel::invalid()</tt>.
+   unique_resource& operator=(BOOST_RV_REF(unique_resource) x) BOOST_NOEXCEPT
+   {
+      this->reset(x.release());
+      m_data.deleter() = ::boost::move(x.m_data.deleter());
+      return *this;
+   }
+
+   //! <b>Returns</b>: The owned handle or <tt>Sentinel::invalid()</tt> if empty.
+   //!
+   Handle get() const BOOST_NOEXCEPT
+   {  return m_data.m_p;  }
+
+   //! <b>Returns</b>: <tt>get() != Sentinel::invalid()</tt>.
+   //!
+   bool valid() const BOOST_NOEXCEPT
+   {  return !(m_data.m_p == Sentinel::invalid());  }
+
+   #ifdef BOOST_MOVE_DOXYGEN_INVOKED
+   //! <b>Returns</b>: <tt>valid()</tt>.
+   //!
+   explicit operator bool
+   #else
+   operator bmupd::explicit_bool_arg
+   #endif
+      ()const BOOST_NOEXCEPT
+   {
+      return this->valid()
+         ? &bmupd::bool_conversion::for_bool
+         : bmupd::explicit_bool_arg(0);
+   }
+
+   //! <b>Returns</b>: A reference to the stored deleter.
+   //!
+   Deleter &get_deleter() BOOST_NOEXCEPT
+   {  return m_data.deleter();  }
+
+   //! <b>Returns</b>: A reference to the stored deleter.
+   //!
+   const Deleter &get_deleter() const BOOST_NOEXCEPT
+   {  return m_data.deleter();  }
+
+   //! <b>Postcondition</b>: <tt>get() == Sentinel::invalid()</tt>.
+   //!
+   //! <b>Returns</b>: The value <tt>get()</tt> had at the start of the call to release.
+   Handle release() BOOST_NOEXCEPT
+   {
+      const Handle tmp = m_data.m_p;
+      m_data.m_p = Sentinel::invalid();
+      return tmp;
+   }
+
+   //! <b>Effects</b>: Stores h and then, if the previous handle was valid, calls the deleter with it.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == h</tt>.
+   void reset(Handle h) BOOST_NOEXCEPT
+   {
+      const Handle tmp = m_data.m_p;
+      m_data.m_p = h;
+      if(!(tmp == Sentinel::invalid()))
+         m_data.deleter()(tmp);
+   }
+
+   //! <b>Effects</b>: <tt>reset(Sentinel::invalid())</tt>.
+   //!
+   void reset() BOOST_NOEXCEPT
+   {  this->reset(Sentinel::invalid());  }
+
+   //! <b>Effects</b>: Exchanges the handles and the deleters of *this and x.
+   //!
+   void swap(unique_resource& x) BOOST_NOEXCEPT
+   {
+      using ::boost::move_detail::swap;
+      swap(m_data.m_p, x.m_data.m_p);
+      swap(m_data.deleter(), x.m_data.deleter());
+   }
+};
+
+//! <b>Effects</b>: Calls <tt>x.swap(y)</tt>.
+//!
+template <class H, class D, class S>
+inline void swap(unique_resource<H, D, S> &x, unique_resource<H, D, S> &y) BOOST_NOEXCEPT
+{  x.swap(y); }
+
+#if defined(BOOST_MOVE_DOXYGEN_INVOKED) || defined(BOOST_HAS_UNISTD_H)
+
+//!The deleter of <tt>unique_fd</tt>: closes a POSIX file descriptor.
+//!
+struct fd_close
+{
+   //! <b>Effects</b>: <tt>::close(fd)</tt>.
+   //!
+   void operator()(int fd) const BOOST_NOEXCEPT
+   {  ::close(fd);  }
+};
+
+//!A move-only owner of a POSIX file descriptor, with the size of an int.
+//!
+typedef unique_resource<int, fd_close, invalid_value_sentinel<int, -1> > unique_fd;
+
+#endif   //#if defined(BOOST_MOVE_DOXYGEN_INVOKED) || defined(BOOST_HAS_UNISTD_H)
+
+}  //namespace movelib {
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace move_upd {
+
+//Releases the handles of [first, last) one by one
+template<class Deleter>
+struct close_all_impl
+{
+   template<class ForwardIt>
+   static void call(ForwardIt first, ForwardIt last) BOOST_NOEXCEPT
+   {
+      for(; first != last; ++first){
+         first->reset();
+      }
+   }
+};
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+//File descriptors are sorted and each run of consecutive descriptors
+//is closed with a single close_range call, if available
+template<>
+struct close_all_impl< ::boost::movelib::fd_close>
+{
+   static void close_run(int lo, int hi) BOOST_NOEXCEPT
+   {
+      #if defined(BOOST_MOVE_HAS_CLOSE_RANGE)
+      if(lo != hi && 0 == ::close_range(unsigned(lo), unsigned(hi), 0)){
+         return;
+      }
+      #endif
+      for(; lo <= hi; ++lo){
+         ::close(lo);
+      }
+   }
+
+   template<class ForwardIt>
+   static void call(ForwardIt first, ForwardIt last) BOOST_NOEXCEPT
+   {
+      std::vector<int> fds;
+      BOOST_TRY{
+         for(ForwardIt it = first; it != last; ++it){
+            if(it->valid())
+               fds.push_back(it->get());
+         }
+      }
+      BOOST_CATCH(...){
+         //Not enough memory to batch: close one by one
+         close_all_impl<void>::call(first, last);
+         return;
+      }
+      BOOST_CATCH_END
+      for(; first != last; ++first){
+         first->release();
+      }
+      std::sort(fds.begin(), fds.end());
+      std::size_t i = 0;
+      const std::size_t n = fds.size();
+      while(i != n){
+         std::size_t j = i;
+         while(j + 1 != n && fds[j + 1] == fds[j] + 1){
+            ++j;
+         }
+         close_run(fds[i], fds[j]);
+         i = j + 1;
+      }
+   }
+};
+
+#endif   //#if defined(BOOST_HAS_UNISTD_H)
+
+}  //namespace move_upd {
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace movelib {
+
+//! <b>Requires</b>: The value type of ForwardIt is a <tt>unique_resource</tt>.
+//!
+//! <b>Effects</b>: Releases the handles owned by the elements of [first, last).
+//!   For <tt>unique_fd</tt> the descriptors are sorted and each run of consecutive
+//!   descriptors is closed with a single <tt>close_range</tt> call where available.
+//!
+//! <b>Postcondition</b>: No element of [first, last) owns a handle.
+template<class ForwardIt>
+inline void close_all(ForwardIt first, ForwardIt last) BOOST_NOEXCEPT
+{
+   typedef typename std::iterator_traits<ForwardIt>::value_type resource_t;
+   ::boost::move_upd::close_all_impl<typename resource_t::deleter_type>::call(first, last);
+}
+
+//! <b>Effects</b>: <tt>close_all(r.begin(), r.end())</tt>.
+//!
+template<class Range>
+inline void close_all(Range &r) BOOST_NOEXCEPT
+{  ::boost::movelib::close_all(r.begin(), r.end());  }
+
+}  //namespace movelib {
+
+//!A moved-from <tt>unique_resource</tt> owns no handle, so only the destructor of its deleter remains.
+//!
+template <class H, class D, class S>
+struct has_trivial_destructor_after_move< ::boost::movelib::unique_resource<H, D, S> >
+   : has_trivial_destructor_after_move<D>
+{};
+
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_UNIQUE_RESOURCE_HPP_INCLUDED
@@ -51,6 +51,7 @@
       < enable_move_utility_emulation<T>::value && has_move_emulation_enabled<T>::value, rv<T>&>::type
          move(T& x) BOOST_NOEXCEPT
    {
+      BOOST_MOVE_TRACE_RVALUE_CAST(T);
       return *static_cast<rv<T>* >(::boost::move_detail::addressof(x));
    }
 
@@ -181,7 +182,10 @@
 
          template <class T>
          inline typename ::boost::move_detail::remove_reference<T>::type && move(T&& t) BOOST_NOEXCEPT
-         { return static_cast<typename ::boost::move_detail::remove_reference<T>::type &&>(t); }
+         {
+            BOOST_MOVE_TRACE_MOVE(T);
+            return static_cast<typename ::boost::move_detail::remove_reference<T>::type &&>(t);
+         }
 
       #endif   //BOOST_MOVE_OLD_RVALUE_REF_BINDING_RULES
 
@@ -0,0 +1,674 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_VALUE_PTR_HPP_INCLUDED
+#define BOOST_MOVE_VALUE_PTR_HPP_INCLUDED
+
+#include <boost/move/detail/config_begin.hpp>
+#include <boost/move/detail/workaround.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/move/detail/memory_utils.hpp>
+#include <boost/move/detail/unique_ptr_meta_utils.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/inplace_unique.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/type_traits/is_polymorphic.hpp>
+#include <boost/type_traits/is_abstract.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
+
+#include <cstddef>   //For std::size_t
+#include <new>       //For placement new
+
+#if !defined(BOOST_NO_CXX11_ALLOCATOR)
+#include <memory>    //For std::allocator_traits
+#endif
+
+#if !defined(BOOST_NO_TYPEID)
+#include <typeinfo>
+#endif
+
+//!\file
+//! Describes <tt>value_ptr</tt>, an owner of polymorphic objects with value semantics
+//! (copies clone the owned object), the cloners <tt>default_clone</tt> and
+//! <tt>allocator_clone</tt>, the deleter <tt>allocator_delete</tt> and
+//! <tt>inplace_value_ptr</tt>, which stores small objects inline.
+
+#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace move_upd {
+
+//////////////////////////////////////
+//        default_clone_impl
+//////////////////////////////////////
+
+//0: non-polymorphic, copy constructs a T
+//1: polymorphic and concrete, copy constructs a T if the dynamic type is T,
+//   otherwise calls clone()
+//2: abstract, calls clone()
+template<class T>
+struct default_clone_kind
+{
+   static const int value = !::boost::is_polymorphic<T>::value ? 0
+                          : ::boost::is_abstract<T>::value ? 2 : 1;
+};
+
+template<class T, int = default_clone_kind<T>::value>
+struct default_clone_impl
+{
+   static T *call(const T &t)
+   {  return new T(t);  }
+};
+
+template<class T>
+struct default_clone_impl<T, 1>
+{
+   static T *call(const T &t)
+   {
+      #if !defined(BOOST_NO_TYPEID)
+      //Avoid the virtual call if the dynamic type is the static type
+      if(bmupmu::is_final<T>::value || typeid(t) == typeid(T)){
+         return new T(t);
+      }
+      #endif
+      return t.clone();
+   }
+};
+
+template<class T>
+struct default_clone_impl<T, 2>
+{
+   static T *call(const T &t)
+   {  return t.clone();  }
+};
+
+//////////////////////////////////////
+//        rebind_alloc
+//////////////////////////////////////
+
+//Alloc::rebind was deprecated in C++17 and removed from std::allocator
+//in C++20, use allocator_traits when available
+template<class Alloc, class T>
+struct rebind_alloc
+{
+   #if !defined(BOOST_NO_CXX11_ALLOCATOR)
+   typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T> type;
+   #else
+   typedef typename Alloc::template rebind<T>::other type;
+   #endif
+};
+
+//////////////////////////////////////
+//        value_ptr_data
+//////////////////////////////////////
+
+//Owns the pointer before the cloner is copied, so that
+//a throwing cloner copy does not leak the object
+template <class T, class D>
+struct value_ptr_owner
+{
+   value_ptr_owner()
+      : m_up()
+   {}
+
+   value_ptr_owner(T *p, const D &d)
+      : m_up(p, d)
+   {}
+
+   ::boost::movelib::unique_ptr<T, D> m_up;
+};
+
+//Applies the empty base optimization to the cloner. The
+//deleter is already optimized away by unique_ptr
+template <class T, class C, class D, bool = bmupmu::is_unary_function<C>::value>
+struct value_ptr_data
+{
+   value_ptr_data()
+      : m_up(), m_c()
+   {}
+
+   value_ptr_data(T *p, const C &c, const D &d)
+      : m_up(p, d), m_c(c)
+   {}
+
+   C &cloner()             { return m_c; }
+   const C &cloner() const { return m_c; }
+
+   ::boost::movelib::unique_ptr<T, D> m_up;
+   C m_c;
+};
+
+//The owner base is declared first so it's initialized before the cloner
+template <class T, class C, class D>
+struct value_ptr_data<T, C, D, false>
+   : value_ptr_owner<T, D>, private C
+{
+   value_ptr_data()
+      : value_ptr_owner<T, D>(), C()
+   {}
+
+   value_ptr_data(T *p, const C &c, const D &d)
+      : value_ptr_owner<T, D>(p, d), C(c)
+   {}
+
+   C &cloner()             { return *this; }
+   const C &cloner() const { return *this; }
+};
+
+//////////////////////////////////////
+//        inplace_value_copy
+//////////////////////////////////////
+template<class T, class Holder, class D>
+struct inplace_value_copy
+{
+   static T *call(Holder &dst, const T &src)
+   {  return &dst.template emplace<D>(static_cast<const D&>(src));  }
+};
+
+}  //namespace move_upd {
+}  //namespace boost{
+
+#endif   //#ifndef BOOST_MOVE_DOXYGEN_INVOKED
+
+namespace boost{
+namespace movelib {
+
+//!The class template <tt>default_clone</tt> is the default cloner of <tt>value_ptr</tt>.
+//!
+//!If T is not polymorphic, it copy constructs a new T with <tt>new</tt>. If T is polymorphic it
+//!calls <tt>t.clone()</tt>, a virtual function that shall return a copy of the dynamic object
+//!allocated with <tt>new</tt>, but if T is not abstract and the dynamic type of the object is T
+//!(checked with <tt>typeid</tt> if available) it avoids the virtual call and copy constructs a T.
+template<class T>
+struct default_clone
+{
+   //! <b>Returns</b>: A copy of t allocated with new.
+   //!
+   T *operator()(const T &t) const
+   {  return bmupd::default_clone_impl<T>::call(t);  }
+};
+
+//!The class template <tt>allocator_clone</tt> is a cloner for <tt>value_ptr</tt> that copy constructs
+//!the object in memory obtained from an allocator of type Alloc (rebound to T). Objects cloned by
+//!<tt>allocator_clone</tt> shall be destroyed by <tt>allocator_delete</tt> using an equal allocator.
+//!
+//!As the size of the dynamic type must be known, T shall be a non-polymorphic or final type.
+//!Allocators whose pointer type is not a raw pointer are not supported.
+template<class T, class Alloc>
+struct allocator_clone
+{
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   BOOST_STATIC_ASSERT(( !::boost::is_polymorphic<T>::value || bmupmu::is_final<T>::value ));
+   typedef typename bmupd::rebind_alloc<Alloc, T>::type allocator_type;
+   #endif
+
+   //! <b>Effects</b>: Stores a copy of a rebound to T.
+   //!
+   explicit allocator_clone(const Alloc &a = Alloc())
+      : m_a(a)
+   {}
+
+   //! <b>Effects</b>: Allocates memory for a T, copy constructs t on it
+   //!   and deallocates the memory if the constructor throws.
+   //!
+   //! <b>Returns</b>: A pointer to the new object.
+   T *operator()(const T &t) const
+   {
+      allocator_type a(m_a);
+      T *const p = a.allocate(1);
+      BOOST_TRY{
+         ::new(static_cast<void*>(p)) T(t);
+      }
+      BOOST_CATCH(...){
+         a.deallocate(p, 1);
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+      return p;
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   allocator_type m_a;
+   #endif
+};
+
+//!The class template <tt>allocator_delete</tt> is a deleter that destroys objects created by
+//!<tt>allocator_clone<T, Alloc></tt> and returns their memory to the allocator.
+template<class T, class Alloc>
+struct allocator_delete
+{
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   typedef typename bmupd::rebind_alloc<Alloc, T>::type allocator_type;
+   #endif
+
+   //! <b>Effects</b>: Stores a copy of a rebound to T.
+   //!
+   explicit allocator_delete(const Alloc &a = Alloc())
+      : m_a(a)
+   {}
+
+   //! <b>Effects</b>: If p is not null, destroys *p and deallocates its memory.
+   //!
+   void operator()(T *p) const BOOST_NOEXCEPT
+   {
+      if(p){
+         allocator_type a(m_a);
+         p->~T();
+         a.deallocate(p, 1);
+      }
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   allocator_type m_a;
+   #endif
+};
+
+//!The class template <tt>value_ptr</tt> owns an object through a pointer, like
+//!<tt>unique_ptr<T, Deleter></tt>, but it is also copyable: copies clone the
+//!owned object calling the cloner. Stateless cloners and deleters take no space.
+//!
+//! \tparam T The static type of the owned object.
+//! \tparam Cloner A function object that returns a copy of a T as a T* that Deleter can delete.
+//! \tparam Deleter A function object that deletes the objects returned by Cloner.
+template < class T
+         , class Cloner  BOOST_MOVE_DOCIGN(= default_clone<T>)
+         , class Deleter BOOST_MOVE_DOCIGN(= default_delete<T>) >
+class value_ptr
+{
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   public:
+   value_ptr(const value_ptr&);
+   value_ptr& operator=(const value_ptr&);
+   private:
+   #else
+   BOOST_COPYABLE_AND_MOVABLE(value_ptr)
+   #endif
+
+   public:
+   typedef T         element_type;
+   typedef T*        pointer;
+   typedef Cloner    cloner_type;
+   typedef Deleter   deleter_type;
+
+   //! <b>Effects</b>: Constructs an empty value_ptr.
+   //!
+   //! <b>Postcondition</b>: <tt>get() == nullptr</tt>.
+   value_ptr()
+      : m_data()
+   {}
+
+   //! <b>Effects</b>: Same as <tt>value_ptr()</tt> (default constructor).
+   //!
+   value_ptr(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type))
+      : m_data()
+   {}
+
+   //! <b>Effects</b>: Takes ownership of p with value-initialized cloner and deleter.
+   //!
+   explicit value_ptr(pointer p)
+      : m_data(p, Cloner(), Deleter())
+   {}
+
+   //! <b>Effects</b>: Takes ownership of p, storing copies of c and d.
+   //!
+   value_ptr(pointer p, const Cloner &c, const Deleter &d)
+      : m_data(p, c, d)
+   {}
+
+   //! <b>Effects</b>: Copies the cloner and the deleter of x and, if x is not empty,
+   //!   owns the result of cloning <tt>*x</tt>.
+   value_ptr(const value_ptr &x)
+      : m_data(x.get() ? x.m_data.cloner()(*x) : pointer(), x.m_data.cloner(), x.get_deleter())
+   {}
+
+   //! <b>Effects</b>: Transfers ownership from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   value_ptr(BOOST_RV_REF(value_ptr) x)
+      : m_data(x.m_data.m_up.release(), x.m_data.cloner(), x.get_deleter())
+   {}
+
+   //! <b>Effects</b>: Replaces the owned object with a clone of <tt>*x</tt>, or with nothing if x is empty.
+   //!   If cloning throws, *this is not modified.
+   value_ptr& operator=(BOOST_COPY_ASSIGN_REF(value_ptr) x)
+   {
+      if(this != &x){
+         value_ptr tmp(x);
+         this->swap(tmp);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the owned object, if any, and transfers ownership from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   value_ptr& operator=(BOOST_RV_REF(value_ptr) x)
+   {
+      if(this != &x){
+         m_data.m_up = ::boost::move(x.m_data.m_up);
+         m_data.cloner() = x.m_data.cloner();
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: <tt>reset()</tt>.
+   //!
+   value_ptr& operator=(BOOST_MOVE_DOC0PTR(bmupd::nullptr_type)) BOOST_NOEXCEPT
+   {  this->reset(); return *this;  }
+
+   //! <b>Returns</b>: A pointer to the owned object or nullptr if empty.
+   //!
+   pointer get() const BOOST_NOEXCEPT
+   {  return m_data.m_up.get();  }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>*get()</tt>.
+   T &operator*() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(this->get());
+      return *this->get();
+   }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>get()</tt>.
+   pointer operator->() const BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(this->get());
+      return this->get();
+   }
+
+   //! <b>Returns</b>: A reference to the stored cloner.
+   //!
+   const Cloner &get_cloner() const BOOST_NOEXCEPT
+   {  return m_data.cloner();  }
+
+   //! <b>Returns</b>: A reference to the stored deleter.
+   //!
+   const Deleter &get_deleter() const BOOST_NOEXCEPT
+   {  return m_data.m_up.get_deleter();  }
+
+   #ifdef BOOST_MOVE_DOXYGEN_INVOKED
+   //! <b>Returns</b>: Returns: get() != nullptr.
+   //!
+   explicit operator bool
+   #else
+   operator bmupd::explicit_bool_arg
+   #endif
+      ()const BOOST_NOEXCEPT
+   {
+      return this->get()
+         ? &bmupd::bool_conversion::for_bool
+         : bmupd::explicit_bool_arg(0);
+   }
+
+   //! <b>Postcondition</b>: <tt>get() == nullptr</tt>.
+   //!
+   //! <b>Returns</b>: The value <tt>get()</tt> had at the start of the call to release.
+   pointer release() BOOST_NOEXCEPT
+   {  return m_data.m_up.release();  }
+
+   //! <b>Effects</b>: Deletes the owned object, if any, and takes ownership of p.
+   //!
+   void reset(pointer p = pointer()) BOOST_NOEXCEPT
+   {  m_data.m_up.reset(p);  }
+
+   //! <b>Effects</b>: Exchanges the owned objects, the cloners and the deleters of *this and x.
+   //!
+   void swap(value_ptr &x)
+   {
+      Cloner tmp(m_data.cloner());
+      m_data.cloner() = x.m_data.cloner();
+      x.m_data.cloner() = tmp;
+      m_data.m_up.swap(x.m_data.m_up);
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   bmupd::value_ptr_data<T, Cloner, Deleter> m_data;
+   #endif
+};
+
+//! <b>Effects</b>: Calls <tt>x.swap(y)</tt>.
+//!
+template <class T, class C, class D>
+inline void swap(value_ptr<T, C, D> &x, value_ptr<T, C, D> &y)
+{  x.swap(y); }
+
+#if defined(BOOST_MOVE_DOXYGEN_INVOKED) || !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+//! <b>Returns</b>: <tt>value_ptr<T>(new T(std::forward<Args>(args)...))</tt>.
+//!
+template<class T, class... Args>
+inline value_ptr<T> make_value_ptr(BOOST_FWD_REF(Args)... args)
+{  return value_ptr<T>(new T(::boost::forward<Args>(args)...));  }
+
+#else
+
+   #define BOOST_PP_LOCAL_MACRO(n) \
+   template<class T BOOST_PP_ENUM_TRAILING_PARAMS(n, class P) > \
+   inline value_ptr<T> make_value_ptr(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_LIST, _)) \
+   {  return value_ptr<T>(new T(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)));  } \
+   //!
+
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+#endif
+
+//! <b>Returns</b>: A value_ptr owning a copy of v allocated with a.
+//!
+template<class T, class Alloc>
+inline value_ptr<T, allocator_clone<T, Alloc>, allocator_delete<T, Alloc> >
+   allocate_value_ptr(const Alloc &a, const T &v)
+{
+   allocator_clone<T, Alloc> c(a);
+   return value_ptr<T, allocator_clone<T, Alloc>, allocator_delete<T, Alloc> >
+      (c(v), c, allocator_delete<T, Alloc>(a));
+}
+
+//!The class template <tt>inplace_value_ptr</tt> is the small-buffer version of <tt>value_ptr</tt>:
+//!it owns an object whose type is T or derived from T, storing it inline when it fits
+//!the buffer as <tt>inplace_unique<T, Size, Align></tt> does, and copies clone the owned object
+//!copy constructing its dynamic type, so no <tt>clone()</tt> function is needed.
+//!
+//!The owned object is created with <tt>emplace<D>(args...)</tt>. D shall be copy and move constructible.
+template< class T
+        , std::size_t Size  BOOST_MOVE_DOCIGN(= 64u)
+        , std::size_t Align BOOST_MOVE_DOCIGN(= ::boost::move_upd::alignment_of< ::boost::move_upd::max_align_t>::value)>
+class inplace_value_ptr
+{
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   public:
+   inplace_value_ptr(const inplace_value_ptr&);
+   inplace_value_ptr& operator=(const inplace_value_ptr&);
+   private:
+   #else
+   BOOST_COPYABLE_AND_MOVABLE(inplace_value_ptr)
+   BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(inplace_value_ptr)
+   #endif
+
+   public:
+   typedef T                                 element_type;
+   typedef T*                                pointer;
+   typedef inplace_unique<T, Size, Align>    holder_type;
+
+   //! <b>Effects</b>: Constructs an empty inplace_value_ptr.
+   //!
+   inplace_value_ptr() BOOST_NOEXCEPT
+      : m_holder(), m_copy()
+   {}
+
+   //! <b>Effects</b>: If x is not empty, owns a copy of <tt>*x</tt> constructed as its dynamic type.
+   //!
+   inplace_value_ptr(const inplace_value_ptr &x)
+      : m_holder(), m_copy()
+   {  this->copy_from(x);  }
+
+   //! <b>Effects</b>: Transfers ownership from x to *this, relocating the owned object if stored inline.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   inplace_value_ptr(BOOST_RV_REF(inplace_value_ptr) x) BOOST_NOEXCEPT
+      : m_holder(::boost::move(x.m_holder)), m_copy(x.m_copy)
+   {  x.m_copy = 0;  }
+
+   //! <b>Effects</b>: Replaces the owned object with a copy of <tt>*x</tt>, or with nothing if x is empty.
+   //!   If copying throws, *this is not modified.
+   inplace_value_ptr& operator=(BOOST_COPY_ASSIGN_REF(inplace_value_ptr) x)
+   {
+      if(this != &x){
+         inplace_value_ptr tmp(x);
+         *this = ::boost::move(tmp);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the owned object, if any, and transfers ownership from x to *this.
+   //!
+   //! <b>Postcondition</b>: <tt>x.get() == nullptr</tt>.
+   inplace_value_ptr& operator=(BOOST_RV_REF(inplace_value_ptr) x) BOOST_NOEXCEPT
+   {
+      if(this != &x){
+         m_holder = ::boost::move(x.m_holder);
+         m_copy = x.m_copy;
+         x.m_copy = 0;
+      }
+      return *this;
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED) || !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+   //! <b>Effects</b>: Destroys the owned object, if any, and constructs an object of type D
+   //!   as <tt>inplace_unique::emplace</tt> does.
+   //!
+   //! <b>Returns</b>: A reference to the new object.
+   template<class D, class... Args>
+   D &emplace(BOOST_FWD_REF(Args)... args)
+   {
+      m_copy = 0;
+      D &d = m_holder.template emplace<D>(::boost::forward<Args>(args)...);
+      m_copy = &bmupd::inplace_value_copy<T, holder_type, D>::call;
+      return d;
+   }
+
+   #else
+
+   #define BOOST_PP_LOCAL_MACRO(n) \
+   template<class D BOOST_PP_ENUM_TRAILING_PARAMS(n, class P) > \
+   D &emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_LIST, _)) \
+   { \
+      m_copy = 0; \
+      D &d = m_holder.template emplace<D>(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)); \
+      m_copy = &bmupd::inplace_value_copy<T, holder_type, D>::call; \
+      return d; \
+   } \
+   //!
+
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+   #endif
+
+   //! <b>Returns</b>: A pointer to the owned object or nullptr if empty.
+   //!
+   pointer get() const BOOST_NOEXCEPT
+   {  return m_holder.get();  }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>*get()</tt>.
+   T &operator*() const BOOST_NOEXCEPT
+   {  return *m_holder;  }
+
+   //! <b>Requires</b>: <tt>get() != nullptr</tt>.
+   //!
+   //! <b>Returns</b>: <tt>get()</tt>.
+   pointer operator->() const BOOST_NOEXCEPT
+   {  return m_holder.operator->();  }
+
+   //! <b>Returns</b>: true if the owned object is stored in the inline buffer.
+   //!
+   bool is_inline() const BOOST_NOEXCEPT
+   {  return m_holder.is_inline();  }
+
+   #ifdef BOOST_MOVE_DOXYGEN_INVOKED
+   //! <b>Returns</b>: Returns: get() != nullptr.
+   //!
+   explicit operator bool
+   #else
+   operator bmupd::explicit_bool_arg
+   #endif
+      ()const BOOST_NOEXCEPT
+   {
+      return this->get()
+         ? &bmupd::bool_conversion::for_bool
+         : bmupd::explicit_bool_arg(0);
+   }
+
+   //! <b>Effects</b>: Destroys the owned object, if any.
+   //!
+   void reset() BOOST_NOEXCEPT
+   {
+      m_holder.reset();
+      m_copy = 0;
+   }
+
+   //! <b>Effects</b>: Exchanges the owned objects of *this and x.
+   //!
+   void swap(inplace_value_ptr &x) BOOST_NOEXCEPT
+   {
+      inplace_value_ptr tmp(::boost::move(x));
+      x = ::boost::move(*this);
+      *this = ::boost::move(tmp);
+   }
+
+   #ifndef BOOST_MOVE_DOXYGEN_INVOKED
+   private:
+   void copy_from(const inplace_value_ptr &x)
+   {
+      if(x.m_copy){
+         x.m_copy(m_holder, *x);
+         m_copy = x.m_copy;
+      }
+   }
+
+   holder_type m_holder;
+   T *(*m_copy)(holder_type &, const T &);
+   #endif
+};
+
+//! <b>Effects</b>: Calls <tt>x.swap(y)</tt>.
+//!
+template <class T, std::size_t Size, std::size_t Align>
+inline void swap(inplace_value_ptr<T, Size, Align> &x, inplace_value_ptr<T, Size, Align> &y) BOOST_NOEXCEPT
+{  x.swap(y); }
+
+}  //namespace movelib {
+
+//!A moved-from <tt>value_ptr</tt> owns no object, so only the destructors of its cloner and deleter remain.
+//!
+template <class T, class C, class D>
+struct has_trivial_destructor_after_move< ::boost::movelib::value_ptr<T, C, D> >
+{
+   static const bool value = has_trivial_destructor_after_move<C>::value &&
+                             has_trivial_destructor_after_move<D>::value;
+};
+
+}  //namespace boost{
+
+#include <boost/move/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_MOVE_VALUE_PTR_HPP_INCLUDED
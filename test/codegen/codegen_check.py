@@ -0,0 +1,162 @@
+#!/usr/bin/env python
+##############################################################################
+##
+## (C) Copyright Ion Gaztanaga 2014-2014 Distributed under the Boost
+## Software License, Version 1.0. (See accompanying file
+## LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+##
+##
+##############################################################################
+"""Checks that move emulation has no overhead in the generated code.
+
+codegen_kernels.cpp is compiled at -O2 in C++03 (move emulation) and C++11
+(rvalue references) modes and disassembled with objdump. For each mode:
+
+ * every boost_xxx kernel must compile to the same instruction sequence
+   as its hand-written ref_xxx kernel, unless the baseline lists the
+   kernel as a known difference.
+ * if the baseline was recorded with the same compiler, no kernel may
+   need more instructions than recorded in the baseline.
+
+Usage:
+   codegen_check.py [--cxx g++] [--objdump objdump] [-I dir]... [--update]
+
+--update rewrites codegen_baseline.txt with the current results.
+"""
+
+from __future__ import print_function
+
+import optparse
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+
+MODES = ['c++03', 'c++11']
+PADDING = re.compile(r'^(nop\w*|data16|xchg|int3|ud2)$')
+FUNCTION = re.compile(r'^[0-9a-f]+ <(\w+)>:$')
+INSTRUCTION = re.compile(r'^\s+[0-9a-f]+:\t(\S+)')
+
+def run(args):
+   p = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+   out, err = p.communicate()
+   if p.returncode != 0:
+      sys.stderr.write(err.decode('utf-8', 'replace'))
+      raise SystemExit('command failed: ' + ' '.join(args))
+   return out.decode('utf-8', 'replace')
+
+def compiler_id(cxx):
+   return run([cxx, '--version']).splitlines()[0].strip() + ' ' + platform.machine()
+
+def disassemble(opts, mode):
+   """Returns a dictionary kernel name -> list of mnemonics"""
+   here = os.path.dirname(os.path.abspath(__file__))
+   fd, obj = tempfile.mkstemp(suffix='.o')
+   os.close(fd)
+   try:
+      args = [opts.cxx, '-std=' + mode, '-O2', '-DNDEBUG', '-c',
+              os.path.join(here, 'codegen_kernels.cpp'), '-o', obj]
+      for d in opts.include + [os.path.join(here, '..', '..', 'include')]:
+         args.append('-I' + d)
+      run(args)
+      dump = run([opts.objdump, '-d', '--no-show-raw-insn', obj])
+   finally:
+      os.remove(obj)
+
+   kernels = {}
+   current = None
+   for line in dump.splitlines():
+      m = FUNCTION.match(line)
+      if m:
+         name = m.group(1)
+         current = name if name.startswith(('boost_', 'ref_')) else None
+         if current:
+            kernels[current] = []
+         continue
+      m = INSTRUCTION.match(line)
+      if m and current:
+         kernels[current].append(m.group(1))
+   #Alignment padding after the last instruction is not part of the kernel
+   for name, code in kernels.items():
+      while code and PADDING.match(code[-1]):
+         code.pop()
+   return kernels
+
+def read_baseline(path):
+   """Returns (compiler id, {(mode, kernel) : (count, same_as_ref)})"""
+   compiler, entries = None, {}
+   if not os.path.exists(path):
+      return compiler, entries
+   for line in open(path):
+      line = line.strip()
+      if line.startswith('# compiler:'):
+         compiler = line[len('# compiler:'):].strip()
+      elif line and not line.startswith('#'):
+         mode, kernel, count, same = line.split()
+         entries[(mode, kernel)] = (int(count), same == 'yes')
+   return compiler, entries
+
+def write_baseline(path, compiler, results):
+   f = open(path, 'w')
+   f.write('# Generated by codegen_check.py --update. Do not edit by hand.\n')
+   f.write('# compiler: ' + compiler + '\n')
+   f.write('# mode kernel instructions same_as_ref\n')
+   for (mode, kernel) in sorted(results):
+      count, same = results[(mode, kernel)]
+      f.write('%s %s %d %s\n' % (mode, kernel, count, 'yes' if same else 'no'))
+   f.close()
+
+def main():
+   parser = optparse.OptionParser(usage=__doc__)
+   parser.add_option('--cxx', default=os.environ.get('CXX', 'g++'))
+   parser.add_option('--objdump', default='objdump')
+   parser.add_option('-I', dest='include', action='append', default=[])
+   parser.add_option('--baseline', default=os.path.join
+      (os.path.dirname(os.path.abspath(__file__)), 'codegen_baseline.txt'))
+   parser.add_option('--update', action='store_true', default=False)
+   opts, args = parser.parse_args()
+
+   compiler = compiler_id(opts.cxx)
+   results = {}
+   for mode in MODES:
+      kernels = disassemble(opts, mode)
+      for name in sorted(kernels):
+         if name.startswith('boost_'):
+            kernel = name[len('boost_'):]
+            code = kernels[name]
+            results[(mode, kernel)] = (len(code), code == kernels.get('ref_' + kernel))
+
+   if opts.update:
+      write_baseline(opts.baseline, compiler, results)
+      print('baseline written to ' + opts.baseline)
+      return 0
+
+   base_compiler, baseline = read_baseline(opts.baseline)
+   same_compiler = base_compiler == compiler
+   if not same_compiler:
+      print('note: baseline recorded with "%s", instruction counts are not compared' % base_compiler)
+
+   errors = 0
+   for (mode, kernel) in sorted(results):
+      count, same = results[(mode, kernel)]
+      base_count, base_same = baseline.get((mode, kernel), (None, True))
+      status = 'ok'
+      if not same and base_same:
+         status = 'FAIL: differs from ref_' + kernel
+      elif same_compiler and base_count is not None and count > base_count:
+         status = 'FAIL: %d instructions, baseline %d' % (count, base_count)
+      elif same and not base_same:
+         status = 'ok (now same as ref_%s, please update the baseline)' % kernel
+      elif same_compiler and base_count is not None and count < base_count:
+         status = 'ok (%d instructions, baseline %d, please update the baseline)' % (count, base_count)
+      elif not same:
+         status = 'ok (known difference from ref_%s)' % kernel
+      if status.startswith('FAIL'):
+         errors += 1
+      print('%-6s %-28s %4d  %s' % (mode, kernel, count, status))
+   return 1 if errors else 0
+
+if __name__ == '__main__':
+   sys.exit(main())
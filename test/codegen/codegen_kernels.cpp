@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Kernels whose generated code is checked by codegen_check.py. Each boost_xxx
+//kernel performs an operation through the library and ref_xxx performs the
+//same operation by hand on builtin types. Moves must have zero overhead, so
+//both kernels must compile to the same number of instructions, both with move
+//emulation (C++03) and with rvalue references (C++11).
+#include <boost/move/utility.hpp>
+#include <boost/move/algorithm.hpp>
+#include <boost/move/iterator.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include "../../example/movable.hpp"
+
+namespace bml = ::boost::movelib;
+
+//A fixed capacity buffer, so push_back has no allocation path
+template<class T>
+class static_buffer
+{
+   public:
+   typedef T value_type;
+   typedef T &reference;
+   typedef const T &const_reference;
+
+   static_buffer() : size_(0) {}
+
+   void push_back(BOOST_RV_REF(T) x)
+   {  storage_[size_++] = ::boost::move(x);  }
+
+   T storage_[64];
+   int size_;
+};
+
+//Same layout as movable, moved by hand
+struct raw_movable
+{  int value_;  };
+
+struct raw_buffer
+{
+   raw_movable storage_[64];
+   int size_;
+};
+
+extern "C" {
+
+//unique_ptr move assignment
+void boost_unique_ptr_move_assign(bml::unique_ptr<int> &dst, bml::unique_ptr<int> &src)
+{  dst = ::boost::move(src);  }
+
+void ref_unique_ptr_move_assign(int *&dst, int *&src)
+{
+   int *const p = src;
+   src = 0;
+   int *const old = dst;
+   dst = p;
+   if(old)
+      delete old;
+}
+
+//unique_ptr move construction and destruction of the moved-from object
+void boost_unique_ptr_move_construct(bml::unique_ptr<int> &src, int **out)
+{
+   bml::unique_ptr<int> tmp(::boost::move(src));
+   *out = tmp.release();
+}
+
+void ref_unique_ptr_move_construct(int *&src, int **out)
+{
+   int *const tmp = src;
+   src = 0;
+   *out = tmp;
+}
+
+//boost::move over movable[]
+void boost_move_range(movable *f, movable *l, movable *r)
+{  ::boost::move(f, l, r);  }
+
+void ref_move_range(raw_movable *f, raw_movable *l, raw_movable *r)
+{
+   for(; f != l; ++f, ++r){
+      r->value_ = f->value_;
+      f->value_ = 0;
+   }
+}
+
+//back_move_inserter loop. In C++03 rv<T> is declared with BOOST_MOVE_ATTRIBUTE_MAY_ALIAS,
+//so the compiler must assume push_back's argument can alias size_ and reloads it
+//in each iteration. The baseline records this as a known difference.
+void boost_back_move_inserter(movable *f, movable *l, static_buffer<movable> &b)
+{  ::boost::move(f, l, ::boost::back_move_inserter(b));  }
+
+void ref_back_move_inserter(raw_movable *f, raw_movable *l, raw_buffer &b)
+{
+   for(; f != l; ++f){
+      raw_movable &dst = b.storage_[b.size_++];
+      dst.value_ = f->value_;
+      f->value_ = 0;
+   }
+}
+
+}  //extern "C" {
@@ -146,6 +146,100 @@ class container
    {  priv_construct(::boost::forward<U>(x));   return iterator();   }
 };
 
+//Same as container, but arguments convertible to T construct the element in place
+template<class T>
+class emplace_container
+{
+   T *storage_;
+   emplace_container(const emplace_container &);
+   emplace_container &operator=(const emplace_container &);
+   public:
+   struct const_iterator{};
+   struct iterator : const_iterator{};
+   emplace_container()
+      : storage_(0)
+   {}
+
+   ~emplace_container()
+   {  delete storage_; }
+
+   BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE(push_back, T, void, priv_push_back, priv_emplace_back)
+
+   BOOST_MOVE_CONVERSION_AWARE_CATCH_EMPLACE_1ARG(insert, T, iterator, priv_insert, priv_emplace, const_iterator, const_iterator)
+
+   template <class Iterator>
+   iterator insert(Iterator, Iterator){ return iterator(); }
+
+   ConstructionType construction_type() const
+   {  return storage_->construction_type(); }
+
+   iterator begin() const { return iterator(); }
+
+   private:
+   template<class U>
+   void priv_construct(BOOST_MOVE_CATCH_FWD(U) x)
+   {
+      if(storage_){
+         delete storage_;
+         storage_ = 0;
+      }
+      storage_ = new T(::boost::forward<U>(x));
+   }
+
+   void priv_push_back(const T &x)
+   {  priv_construct(x);   }
+
+   void priv_push_back(BOOST_RV_REF(T) x)
+   {  priv_construct(::boost::move(x));   }
+
+   template<class U>
+   void priv_emplace_back(BOOST_MOVE_CATCH_FWD(U) x)
+   {  priv_construct(::boost::forward<U>(x));   }
+
+   iterator priv_insert(const_iterator, const T &x)
+   {  priv_construct(x);   return iterator();   }
+
+   iterator priv_insert(const_iterator, BOOST_RV_REF(T) x)
+   {  priv_construct(::boost::move(x));   return iterator();   }
+
+   template<class U>
+   iterator priv_emplace(const_iterator, BOOST_MOVE_CATCH_FWD(U) x)
+   {  priv_construct(::boost::forward<U>(x));   return iterator();   }
+};
+
+template<class T>
+void test_emplace_container()
+{
+   emplace_container<T> c;
+   {
+      conversion_source x;
+      c.push_back(x);
+      assert(c.construction_type() == Other);
+      c.insert(c.begin(), x);
+      assert(c.construction_type() == Other);
+   }
+   {
+      const conversion_source x;
+      c.push_back(x);
+      assert(c.construction_type() == Other);
+      c.insert(c.begin(), x);
+      assert(c.construction_type() == Other);
+   }
+   {
+      c.push_back(conversion_source());
+      assert(c.construction_type() == Other);
+      c.insert(c.begin(), conversion_source());
+      assert(c.construction_type() == Other);
+   }
+   {
+      c.push_back(T());
+      assert(c.construction_type() == Moved);
+      c.insert(c.begin(), T());
+      assert(c.construction_type() == Moved);
+   }
+   c.insert(c.begin(), c.begin());
+}
+
 class recursive_container
 {
    BOOST_COPYABLE_AND_MOVABLE(recursive_container)
@@ -402,6 +496,26 @@ int main()
       c.insert(c.begin(), c.begin());
    }
 
+   //Convertible arguments are constructed in place, without a temporary
+   test_emplace_container<conversion_target_copymovable>();
+   test_emplace_container<conversion_target_movable>();
+   {
+      emplace_container<conversion_target_copymovable> c;
+      conversion_target_copymovable x;
+      c.push_back(x);
+      assert(c.construction_type() == Copied);
+      const conversion_target_copymovable &cx = x;
+      c.insert(c.begin(), cx);
+      assert(c.construction_type() == Copied);
+   }
+   {
+      emplace_container<int> c;
+      c.push_back(conversion_source());
+      c.insert(c.begin(), conversion_source());
+      c.push_back(1);
+      c.insert(c.begin(), 1);
+   }
+
    {
       recursive_container c;
       recursive_container internal;
@@ -10,9 +10,13 @@
 //avoid copy constructor overloading.
 #include <boost/move/detail/config_begin.hpp>
 #include <boost/move/utility.hpp>
-#include <iostream>
+#include <boost/core/lightweight_test.hpp>
 
-bool moved = false;
+//Only assignments and constructions that can't be elided are checked
+int copy_constructions = 0;
+int move_constructions = 0;
+int copy_assignments = 0;
+int move_assignments = 0;
 
 class obj
 {
@@ -20,33 +24,31 @@ class obj
    public:
 
    obj()
-   {
-      std::cout << "constructing obj" << "\n";
-   }
+   {}
 
    ~obj()
    {}
 
    obj(const obj &)
    {
-      std::cout << "copy construct from const obj" << "\n";
+      ++copy_constructions;
    }
 
    // copy construct from movable object (non-const rvalue, explicitly moved lvalue)
    obj(BOOST_RV_REF(obj))
    {
-      std::cout << "move construct from movable rvalue" << "\n";
+      ++move_constructions;
    }
 
    obj& operator =(BOOST_COPY_ASSIGN_REF(obj))
    {
-      std::cout << "copy assign from const obj" << "\n";
+      ++copy_assignments;
       return *this;
    }
 
    obj& operator =(BOOST_RV_REF(obj))
    {
-      std::cout << "move assign from movable rvalue" << "\n";
+      ++move_assignments;
       return *this;
    }
 };
@@ -61,6 +63,25 @@ obj produce()     { return obj(); }
 
 void consume(obj){}
 
+void reset_counters()
+{
+   copy_constructions = move_constructions = copy_assignments = move_assignments = 0;
+}
+
+bool copy_assigned()
+{
+   const bool r = copy_assignments == 1 && move_assignments == 0;
+   reset_counters();
+   return r;
+}
+
+bool move_assigned()
+{
+   const bool r = copy_assignments == 0 && move_assignments == 1;
+   reset_counters();
+   return r;
+}
+
 int main()
 {
    {  consume(produce());  }
@@ -69,32 +90,63 @@ int main()
    {
    obj o1(rvalue_func());
    obj o2 = const_rvalue_func();
+   reset_counters();
    obj o3 = lvalue_func();
+   BOOST_TEST(copy_constructions == 1 && move_constructions == 0);
+   reset_counters();
    obj o4 = const_lvalue_func();
+   BOOST_TEST(copy_constructions == 1 && move_constructions == 0);
    // can't explicitly move temporaries
    //obj o5 = boost::move(rvalue_func());
    obj o5;
-   //Maybe missed optimization: copied
+   reset_counters();
+   //Non-const temporaries are converted to rv<obj>& by the non-const
+   //conversion operator of BOOST_COPYABLE_AND_MOVABLE, so they are moved
+   //also in C++03 compilers
    o5 = rvalue_func();
-   //Explicit forward works OK and optimized
+   BOOST_TEST(move_assigned());
    o5 = boost::forward<obj>(rvalue_func());
-
+   #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   //In C++03 boost::forward<obj> can't tell an rvalue from a const lvalue
+   //(BOOST_FWD_REF(obj) is const obj &), so it must copy
+   BOOST_TEST(copy_assigned());
+   #else
+   BOOST_TEST(move_assigned());
+   #endif
+
+   reset_counters();
    obj o7 = boost::move(lvalue_func());
+   BOOST_TEST(copy_constructions == 0 && move_constructions == 1);
+   reset_counters();
    obj o8 = boost::move(const_lvalue_func());
+   BOOST_TEST(copy_constructions == 1 && move_constructions == 0);
 
    obj o;
+   reset_counters();
    o = rvalue_func();
+   BOOST_TEST(move_assigned());
    o = const_rvalue_func();
+   BOOST_TEST(copy_assigned());
    o = lvalue_func();
+   BOOST_TEST(copy_assigned());
    o = const_lvalue_func();
+   BOOST_TEST(copy_assigned());
    // can't explicitly move temporaries
    //o = boost::move(rvalue_func());
    o = boost::forward<obj>(rvalue_func());
+   #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   BOOST_TEST(copy_assigned());
+   #else
+   BOOST_TEST(move_assigned());
+   #endif
    o = boost::move(const_rvalue_func());
+   BOOST_TEST(copy_assigned());
    o = boost::move(lvalue_func());
+   BOOST_TEST(move_assigned());
    o = boost::move(const_lvalue_func());
+   BOOST_TEST(copy_assigned());
    }
-   return 0;
+   return boost::report_errors();
 }
 
 //We need to declare:
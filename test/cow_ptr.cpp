@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/cow_ptr.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+namespace bml = ::boost::movelib;
+
+class Doc
+{
+   BOOST_COPYABLE_AND_MOVABLE(Doc)
+
+   public:
+   static int count;
+   static int copies;
+   static int moves;
+   int a, b;
+
+   Doc() : a(0), b(0) {  ++count;  }
+   Doc(int x, int y) : a(x), b(y) {  ++count;  }
+   Doc(const Doc &x) : a(x.a), b(x.b) {  ++count; ++copies;  }
+   Doc(BOOST_RV_REF(Doc) x) : a(x.a), b(x.b) {  x.a = x.b = -1; ++count; ++moves;  }
+   ~Doc() {  --count;  }
+
+   Doc &operator=(BOOST_COPY_ASSIGN_REF(Doc) x) {  a = x.a; b = x.b; return *this;  }
+   Doc &operator=(BOOST_RV_REF(Doc) x) {  a = x.a; b = x.b; return *this;  }
+};
+
+int Doc::count = 0;
+int Doc::copies = 0;
+int Doc::moves = 0;
+
+void reset_counters()
+{  Doc::count = 0; Doc::copies = 0; Doc::moves = 0;  }
+
+////////////////////////////////
+//   cow_ptr_share
+////////////////////////////////
+
+namespace cow_ptr_share{
+
+void test()
+{
+   reset_counters();
+   {
+      bml::cow_ptr<Doc> a;
+      BOOST_TEST(!a);
+      BOOST_TEST(a.get() == 0);
+      BOOST_TEST(a.use_count() == 0);
+
+      a = bml::make_cow<Doc>(1, 2);
+      BOOST_TEST(!!a);
+      BOOST_TEST(a.unique());
+      BOOST_TEST(a->a == 1 && (*a).b == 2);
+      BOOST_TEST(Doc::count == 1);
+
+      //Copies share the value
+      bml::cow_ptr<Doc> b(a);
+      bml::cow_ptr<Doc> c;
+      c = b;
+      BOOST_TEST(a.get() == b.get() && b.get() == c.get());
+      BOOST_TEST(a == c);
+      BOOST_TEST(a.use_count() == 3);
+      BOOST_TEST(Doc::count == 1);
+      BOOST_TEST(Doc::copies == 0);
+
+      //Self assignment
+      c = c;
+      BOOST_TEST(c.use_count() == 3);
+
+      //Releasing owners
+      c.reset();
+      BOOST_TEST(!c);
+      BOOST_TEST(a.use_count() == 2);
+      b = bml::cow_ptr<Doc>();
+      BOOST_TEST(a.unique());
+      BOOST_TEST(Doc::count == 1);
+   }
+   BOOST_TEST(Doc::count == 0);
+}
+
+}  //namespace cow_ptr_share{
+
+////////////////////////////////
+//   cow_ptr_write
+////////////////////////////////
+
+namespace cow_ptr_write{
+
+void test()
+{
+   reset_counters();
+   {
+      bml::cow_ptr<Doc> a(bml::make_cow<Doc>(1, 2));
+      const Doc *const p = a.get();
+
+      //The only owner writes in place
+      a.write().a = 3;
+      BOOST_TEST(a.get() == p);
+      BOOST_TEST(Doc::copies == 0);
+
+      //A shared value is copied before writing
+      bml::cow_ptr<Doc> b(a);
+      b.write().b = 4;
+      BOOST_TEST(Doc::copies == 1);
+      BOOST_TEST(Doc::count == 2);
+      BOOST_TEST(a.get() == p);
+      BOOST_TEST(b.get() != p);
+      BOOST_TEST(a->a == 3 && a->b == 2);
+      BOOST_TEST(b->a == 3 && b->b == 4);
+      BOOST_TEST(a.unique() && b.unique());
+
+      //Now unique, no more copies
+      b.write().b = 5;
+      BOOST_TEST(Doc::copies == 1);
+   }
+   BOOST_TEST(Doc::count == 0);
+   {
+      //Construction from a value
+      Doc d(1, 1);
+      bml::cow_ptr<Doc> a(d);
+      BOOST_TEST(Doc::copies == 2);
+      bml::cow_ptr<Doc> b(boost::move(d));
+      BOOST_TEST(Doc::moves == 1);
+      BOOST_TEST(b->a == 1 && d.a == -1);
+
+      bml::cow_ptr<int> i(bml::make_cow<int>(7));
+      bml::cow_ptr<int> j(i);
+      j.write() = 8;
+      BOOST_TEST(*i == 7 && *j == 8);
+   }
+   BOOST_TEST(Doc::count == 0);
+}
+
+}  //namespace cow_ptr_write{
+
+////////////////////////////////
+//   cow_ptr_move
+////////////////////////////////
+
+namespace cow_ptr_move{
+
+bml::cow_ptr<Doc> make()
+{  return bml::make_cow<Doc>();  }
+
+void test()
+{
+   reset_counters();
+   {
+      bml::cow_ptr<Doc> a(make());
+      bml::cow_ptr<Doc> b(a);
+      const Doc *const p = a.get();
+
+      //Moves don't touch the count
+      bml::cow_ptr<Doc> c(boost::move(a));
+      BOOST_TEST(!a);
+      BOOST_TEST(c.get() == p);
+      BOOST_TEST(c.use_count() == 2);
+      a = boost::move(c);
+      BOOST_TEST(!c);
+      BOOST_TEST(a.use_count() == 2);
+
+      swap(a, c);
+      BOOST_TEST(!a);
+      BOOST_TEST(c.get() == p);
+      BOOST_TEST(c.use_count() == 2);
+      BOOST_TEST(Doc::count == 1);
+      BOOST_TEST(Doc::copies == 0);
+   }
+   BOOST_TEST(Doc::count == 0);
+}
+
+}  //namespace cow_ptr_move{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   cow_ptr_share::test();
+   cow_ptr_write::test();
+   cow_ptr_move::test();
+
+   //Test results
+   return boost::report_errors();
+}
@@ -0,0 +1,229 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/deferred_delete.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+#include <thread>
+#include <atomic>
+#endif
+
+namespace bml = ::boost::movelib;
+
+struct A
+{
+   static int count;
+   A() {++count;}
+   virtual ~A() {--count;}
+};
+
+int A::count = 0;
+
+struct B
+   : public A
+{
+   static int count;
+   B() {++count;}
+   virtual ~B() {--count;}
+};
+
+int B::count = 0;
+
+void reset_counters()
+{  A::count = B::count = 0;  }
+
+#if defined(BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL)
+const bool deferred = true;
+#else
+const bool deferred = false;
+#endif
+
+////////////////////////////////
+//   deferred_delete_flush
+////////////////////////////////
+
+namespace deferred_delete_flush{
+
+void test()
+{
+   reset_counters();
+   {
+      bml::unique_ptr<A, bml::deferred_delete<A> > p(new A);
+      BOOST_TEST(A::count == 1);
+   }
+   BOOST_TEST(A::count == (deferred ? 1 : 0));
+   BOOST_TEST(bml::deferred_delete<A>::pending() == (deferred ? 1u : 0u));
+   //Flush is not type-dependent
+   bml::deferred_delete<int>::flush();
+   BOOST_TEST(A::count == 0);
+   BOOST_TEST(bml::deferred_delete<A>::pending() == 0u);
+   //Converting deleter and polymorphic deletion
+   {
+      bml::unique_ptr<B, bml::deferred_delete<B> > pb(new B);
+      bml::unique_ptr<A, bml::deferred_delete<A> > pa(::boost::move(pb));
+      BOOST_TEST(A::count == 1);
+      BOOST_TEST(B::count == 1);
+   }
+   bml::deferred_delete<A>::flush();
+   BOOST_TEST(A::count == 0);
+   BOOST_TEST(B::count == 0);
+   //Arrays
+   {
+      bml::unique_ptr<A[], bml::deferred_delete<A[]> > p(new A[5]);
+      BOOST_TEST(A::count == 5);
+      p.reset();
+      BOOST_TEST(A::count == (deferred ? 5 : 0));
+   }
+   bml::deferred_delete<A[]>::flush();
+   BOOST_TEST(A::count == 0);
+   //Null pointers are not retired
+   {
+      bml::unique_ptr<A, bml::deferred_delete<A> > p;
+      bml::deferred_delete<A>()(static_cast<A*>(0));
+   }
+   BOOST_TEST(bml::deferred_delete<A>::pending() == 0u);
+}
+
+}  //namespace deferred_delete_flush{
+
+////////////////////////////////
+//   deferred_delete_batch
+////////////////////////////////
+
+namespace deferred_delete_batch{
+
+void test()
+{
+   #if defined(BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL)
+   reset_counters();
+   const int n = BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE;
+   for(int i = 0; i != n; ++i){
+      bml::unique_ptr<A, bml::deferred_delete<A> > p(new A);
+   }
+   BOOST_TEST(A::count == n);
+   BOOST_TEST(bml::deferred_delete<A>::pending() == std::size_t(n));
+   //The buffer is full, the next retirement drains it
+   {
+      bml::unique_ptr<A, bml::deferred_delete<A> > p(new A);
+   }
+   BOOST_TEST(A::count == 1);
+   BOOST_TEST(bml::deferred_delete<A>::pending() == 1u);
+   bml::deferred_delete<A>::flush();
+   BOOST_TEST(A::count == 0);
+   #endif   //#if defined(BOOST_MOVE_DEFERRED_DELETE_THREAD_LOCAL)
+}
+
+}  //namespace deferred_delete_batch{
+
+////////////////////////////////
+//   deferred_delete_nested
+////////////////////////////////
+
+namespace deferred_delete_nested{
+
+struct node
+{
+   static int count;
+   node() {++count;}
+   ~node() {--count;}
+   bml::unique_ptr<node, bml::deferred_delete<node> > next;
+};
+
+int node::count = 0;
+
+void test()
+{
+   //A long list would overflow the stack with recursive destruction,
+   //deferred destruction drains it iteratively
+   const int n = 100000;
+   {
+      bml::unique_ptr<node, bml::deferred_delete<node> > head(new node);
+      node *last = head.get();
+      for(int i = 1; i != n; ++i){
+         last->next.reset(new node);
+         last = last->next.get();
+      }
+      BOOST_TEST(node::count == n);
+   }
+   bml::deferred_delete<node>::flush();
+   BOOST_TEST(node::count == 0);
+   BOOST_TEST(bml::deferred_delete<node>::pending() == 0u);
+}
+
+}  //namespace deferred_delete_nested{
+
+////////////////////////////////
+//   deferred_delete_reclaimer
+////////////////////////////////
+
+namespace deferred_delete_reclaimer{
+
+#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+
+std::atomic<int> live(0);
+std::atomic<int> destroyed_elsewhere(0);
+std::thread::id owner;
+
+struct C
+{
+   C() {++live;}
+   ~C()
+   {
+      --live;
+      if(std::this_thread::get_id() != owner)
+         ++destroyed_elsewhere;
+   }
+};
+
+#endif   //#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+
+void test()
+{
+   #if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+   owner = std::this_thread::get_id();
+   const int n = BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE*4;
+   {
+      bml::deferred_reclaimer r;
+      for(int i = 0; i != n; ++i){
+         bml::unique_ptr<C, bml::deferred_delete<C> > p(new C);
+      }
+      //The buffer is full, the last batch is still in this thread
+      BOOST_TEST(bml::deferred_delete<C>::pending() == std::size_t(BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE));
+   }
+   //Handed off batches were destroyed by the reclaimer
+   BOOST_TEST(destroyed_elsewhere == n - BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE);
+   BOOST_TEST(live == BOOST_MOVE_DEFERRED_DELETE_BATCH_SIZE);
+   bml::deferred_delete<C>::flush();
+   BOOST_TEST(live == 0);
+   //Threads drain their buffer on exit
+   std::thread t([]{ bml::unique_ptr<C, bml::deferred_delete<C> > p(new C); });
+   t.join();
+   BOOST_TEST(live == 0);
+   #endif   //#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+}
+
+}  //namespace deferred_delete_reclaimer{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   deferred_delete_flush::test();
+   deferred_delete_batch::test();
+   deferred_delete_nested::test();
+   deferred_delete_reclaimer::test();
+
+   //Test results
+   return boost::report_errors();
+}
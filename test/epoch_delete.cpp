@@ -0,0 +1,183 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/epoch_delete.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#if defined(BOOST_MOVE_HAS_EPOCH_DELETE)
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace bml = ::boost::movelib;
+
+struct A
+{
+   static std::atomic<int> count;
+   static const unsigned alive_tag = 0xA11CEu;
+   unsigned tag;
+   int value;
+   explicit A(int v = 0) : tag(alive_tag), value(v) {++count;}
+   ~A() {tag = 0; --count;}
+};
+
+std::atomic<int> A::count(0);
+
+typedef bml::unique_ptr<A, bml::epoch_delete<A> > ptr_t;
+
+////////////////////////////////
+//   epoch_delete_retire
+////////////////////////////////
+
+namespace epoch_delete_retire{
+
+void test()
+{
+   A::count = 0;
+   {
+      ptr_t p(new A);
+      BOOST_TEST(A::count == 1);
+   }
+   //Retired, not destroyed inline
+   BOOST_TEST(A::count == 1);
+   BOOST_TEST(bml::epoch_delete<A>::pending() == 1u);
+   bml::epoch_delete<A>::flush();
+   BOOST_TEST(A::count == 0);
+   BOOST_TEST(bml::epoch_delete<A>::pending() == 0u);
+   //Arrays
+   {
+      bml::unique_ptr<A[], bml::epoch_delete<A[]> > p(new A[3]);
+      BOOST_TEST(A::count == 3);
+   }
+   bml::epoch_delete<int>::flush();
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace epoch_delete_retire{
+
+////////////////////////////////
+//   epoch_delete_reader
+////////////////////////////////
+
+namespace epoch_delete_reader{
+
+void test_slot()
+{
+   std::atomic<int> state(0);
+   bml::epoch_slot<A> slot(ptr_t(new A(1)));
+   A *seen = 0;
+
+   //The reader enters a critical section and loads the object
+   std::thread reader([&]{
+      bml::epoch_guard g;
+      seen = slot.load();
+      state = 1;
+      while(state != 2) std::this_thread::yield();
+      //Still alive although replaced
+      BOOST_TEST(seen->tag == A::alive_tag);
+      BOOST_TEST(seen->value == 1);
+   });
+   while(state != 1) std::this_thread::yield();
+   slot.store(ptr_t(new A(2)));
+   BOOST_TEST(A::count == 2);
+   //The reader blocks the advance of the epoch
+   for(int i = 0; i != 10; ++i){
+      bml::epoch_delete<A>::reclaim();
+   }
+   BOOST_TEST(A::count == 2);
+   state = 2;
+   reader.join();
+   bml::epoch_delete<A>::flush();
+   BOOST_TEST(A::count == 1);
+   {
+      bml::epoch_guard g;
+      BOOST_TEST(slot.load()->value == 2);
+      //Guards can be nested
+      bml::epoch_guard g2;
+      ptr_t old(slot.exchange(ptr_t(new A(3))));
+      BOOST_TEST(old->value == 2);
+   }
+   bml::epoch_delete<A>::flush();
+   BOOST_TEST(A::count == 1);
+}
+
+void test()
+{
+   A::count = 0;
+   test_slot();
+   //The slot retires its object when destroyed
+   BOOST_TEST(A::count == 1);
+   bml::epoch_delete<A>::flush();
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace epoch_delete_reader{
+
+////////////////////////////////
+//   epoch_delete_stress
+////////////////////////////////
+
+namespace epoch_delete_stress{
+
+void test()
+{
+   A::count = 0;
+   const int readers = 4;
+   const int updates = 20000;
+   std::atomic<bool> stop(false);
+   std::atomic<int> errors(0);
+   {
+      bml::epoch_slot<A> slot(ptr_t(new A(0)));
+      std::vector<std::thread> threads;
+      for(int i = 0; i != readers; ++i){
+         threads.push_back(std::thread([&]{
+            int last = 0;
+            while(!stop){
+               bml::epoch_guard g;
+               A *const a = slot.load();
+               if(a->tag != A::alive_tag || a->value < last)
+                  ++errors;
+               last = a->value;
+            }
+         }));
+      }
+      for(int i = 1; i <= updates; ++i){
+         slot.store(ptr_t(new A(i)));
+      }
+      stop = true;
+      for(int i = 0; i != readers; ++i){
+         threads[i].join();
+      }
+   }
+   bml::epoch_delete<A>::flush();
+   BOOST_TEST(errors == 0);
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace epoch_delete_stress{
+
+#endif   //#if defined(BOOST_MOVE_HAS_EPOCH_DELETE)
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   #if defined(BOOST_MOVE_HAS_EPOCH_DELETE)
+   epoch_delete_retire::test();
+   epoch_delete_reader::test();
+   epoch_delete_stress::test();
+   #endif
+
+   //Test results
+   return boost::report_errors();
+}
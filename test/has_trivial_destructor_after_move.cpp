@@ -0,0 +1,213 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/traits.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/value_ptr.hpp>
+#include <boost/move/cow_ptr.hpp>
+#include <boost/move/unique_array.hpp>
+#include <boost/move/inplace_unique.hpp>
+#include <boost/move/unique_resource.hpp>
+#include <boost/move/relative_ptr.hpp>
+#include <boost/move/aligned_delete.hpp>
+#include <boost/move/trailing_delete.hpp>
+#include <boost/move/recycle_delete.hpp>
+#include <boost/move/fn_deleter.hpp>
+#include <boost/move/slab_delete.hpp>
+#include <boost/move/epoch_delete.hpp>
+#include <boost/move/deferred_delete.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+namespace bml = ::boost::movelib;
+
+//A deleter whose destructor must run
+struct stateful_deleter
+{
+   stateful_deleter() : m_calls(0) {}
+   ~stateful_deleter() { m_calls = -1; }
+   void operator()(int *p) const { delete p; }
+   int m_calls;
+};
+
+//A cloner whose destructor must run
+struct stateful_cloner
+{
+   ~stateful_cloner() {}
+   int *operator()(const int &i) const { return new int(i); }
+};
+
+struct base
+{
+   virtual ~base(){}
+   virtual int get() const = 0;
+};
+
+struct derived : base
+{
+   derived() {}
+   derived(const derived &) : base() {}
+   virtual int get() const { return 1; }
+};
+
+void free_int(int *p)
+{  delete p;  }
+
+void close_handle(int)
+{}
+
+////////////////////////////////
+//   library_types
+////////////////////////////////
+
+namespace library_types{
+
+template<class T>
+struct trivial
+{
+   static const bool value = boost::has_trivial_destructor_after_move<T>::value;
+};
+
+//Deleters
+BOOST_STATIC_ASSERT(( trivial< bml::default_delete<int> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::default_delete<int[]> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::fn_deleter<void(*)(int*), &free_int> >::value ));
+BOOST_STATIC_ASSERT(( !trivial< stateful_deleter >::value ));
+
+//unique_ptr depends only on its deleter
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int[]> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int[2]> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<base> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, void(*)(int*)> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, bml::fn_deleter<void(*)(int*), &free_int> > >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, bml::aligned_delete<int> > >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, bml::trailing_delete<int, char> > >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, bml::recycle_delete<int> > >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, stateful_deleter&> >::value ));
+BOOST_STATIC_ASSERT(( !trivial< bml::unique_ptr<int, stateful_deleter> >::value ));
+#if defined(BOOST_MOVE_HAS_SLAB_DELETE)
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, bml::slab_delete<int> > >::value ));
+#endif
+#if defined(BOOST_MOVE_HAS_EPOCH_DELETE)
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, bml::epoch_delete<int> > >::value ));
+#endif
+#if defined(BOOST_MOVE_HAS_DEFERRED_RECLAIMER)
+BOOST_STATIC_ASSERT(( trivial< bml::unique_ptr<int, bml::deferred_delete<int> > >::value ));
+#endif
+
+//Other owners
+BOOST_STATIC_ASSERT(( trivial< bml::value_ptr<int> >::value ));
+BOOST_STATIC_ASSERT(( !trivial< bml::value_ptr<int, stateful_cloner> >::value ));
+BOOST_STATIC_ASSERT(( !trivial< bml::value_ptr<int, bml::default_clone<int>, stateful_deleter> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::inplace_value_ptr<base> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::cow_ptr<int> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_array<int> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::inplace_unique<base> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::unique_resource<int, void(*)(int)> >::value ));
+BOOST_STATIC_ASSERT(( trivial< bml::relative_ptr<int> >::value ));
+
+void test()
+{
+   //Moved-from owners marked with BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE must own nothing
+   {
+      bml::cow_ptr<int> a(bml::make_cow<int>(1));
+      bml::cow_ptr<int> b(boost::move(a));
+      BOOST_TEST(a.get() == 0);
+   }
+   {
+      bml::unique_array<int> a(bml::make_unique_array<int>(3));
+      bml::unique_array<int> b(boost::move(a));
+      BOOST_TEST(a.get() == 0 && a.size() == 0);
+   }
+   {
+      bml::inplace_unique<base> a;
+      a.emplace<derived>();
+      bml::inplace_unique<base> b(boost::move(a));
+      BOOST_TEST(a.get() == 0);
+      BOOST_TEST(b->get() == 1);
+   }
+   {
+      bml::inplace_value_ptr<base> a;
+      a.emplace<derived>();
+      bml::inplace_value_ptr<base> b(boost::move(a));
+      BOOST_TEST(a.get() == 0);
+      BOOST_TEST(b->get() == 1);
+   }
+}
+
+}  //namespace library_types{
+
+////////////////////////////////
+//   marked_types
+////////////////////////////////
+
+namespace marked_types{
+
+class marked
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(marked)
+   BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(marked)
+
+   public:
+   marked() : m_p(new int(0)) {}
+   marked(BOOST_RV_REF(marked) x) : m_p(x.m_p) { x.m_p = 0; }
+   marked& operator=(BOOST_RV_REF(marked) x)
+   {  int *p = x.m_p; x.m_p = 0; delete m_p; m_p = p; return *this;  }
+   ~marked() { delete m_p; }
+   int *m_p;
+};
+
+//The marker is not inherited
+class derived_marked
+   : public marked
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(derived_marked)
+
+   public:
+   derived_marked() {}
+   derived_marked(BOOST_RV_REF(derived_marked) x) : marked(boost::move(static_cast<marked&>(x))) {}
+   ~derived_marked() {}
+};
+
+class unmarked
+{
+   public:
+   ~unmarked() {}
+};
+
+BOOST_STATIC_ASSERT(( boost::has_trivial_destructor_after_move<marked>::value ));
+BOOST_STATIC_ASSERT(( boost::has_trivial_destructor_after_move<const marked>::value ));
+BOOST_STATIC_ASSERT(( !boost::has_trivial_destructor_after_move<derived_marked>::value ));
+BOOST_STATIC_ASSERT(( !boost::has_trivial_destructor_after_move<unmarked>::value ));
+BOOST_STATIC_ASSERT(( boost::has_trivial_destructor_after_move<bml::unique_ptr<int, marked> >::value ));
+
+void test()
+{
+   marked a;
+   marked b(boost::move(a));
+   BOOST_TEST(a.m_p == 0);
+   BOOST_TEST(b.m_p != 0);
+}
+
+}  //namespace marked_types{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   library_types::test();
+   marked_types::test();
+
+   //Test results
+   return boost::report_errors();
+}
@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/inplace_unique.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+namespace bml = ::boost::movelib;
+
+class Base
+{
+   public:
+   static int count;
+   Base() {++count;}
+   virtual ~Base() {--count;}
+   virtual int value() const = 0;
+};
+
+int Base::count = 0;
+
+class Small : public Base
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(Small)
+
+   public:
+   static int moves;
+   int v;
+   explicit Small(int x) : v(x) {}
+   Small(BOOST_RV_REF(Small) x) : Base(), v(x.v) {  x.v = -1; ++moves;  }
+   Small& operator=(BOOST_RV_REF(Small) x) {  v = x.v; x.v = -1; return *this;  }
+   virtual int value() const {  return v;  }
+};
+
+int Small::moves = 0;
+
+class Big : public Base
+{
+   public:
+   char data[256];
+   int v;
+   Big(int x, char c) : v(x) {  data[0] = c;  }
+   virtual int value() const {  return v + data[0];  }
+};
+
+void reset_counters()
+{  Base::count = 0; Small::moves = 0;  }
+
+typedef bml::inplace_unique<Base, 32> holder_t;
+
+////////////////////////////////
+//   inplace_unique_emplace
+////////////////////////////////
+
+namespace inplace_unique_emplace{
+
+void test()
+{
+   reset_counters();
+   BOOST_TEST((holder_t::fits_inline<Small>::value));
+   BOOST_TEST((!holder_t::fits_inline<Big>::value));
+   {
+      holder_t h;
+      BOOST_TEST(!h);
+      BOOST_TEST(!h.get());
+      Small &s = h.emplace<Small>(3);
+      BOOST_TEST(!!h);
+      BOOST_TEST(h.is_inline());
+      BOOST_TEST(h.get() == &s);
+      BOOST_TEST(h->value() == 3);
+      BOOST_TEST((*h).value() == 3);
+      //Stored inside the holder
+      BOOST_TEST(reinterpret_cast<char*>(h.get()) >= reinterpret_cast<char*>(&h));
+      BOOST_TEST(reinterpret_cast<char*>(h.get()) <  reinterpret_cast<char*>(&h) + sizeof(h));
+      BOOST_TEST(Base::count == 1);
+      h.emplace<Big>(1, char(2));
+      BOOST_TEST(Base::count == 1);
+      BOOST_TEST(!h.is_inline());
+      BOOST_TEST(h->value() == 3);
+      h.reset();
+      BOOST_TEST(Base::count == 0);
+      BOOST_TEST(!h);
+   }
+   BOOST_TEST(Base::count == 0);
+}
+
+}  //namespace inplace_unique_emplace{
+
+////////////////////////////////
+//   inplace_unique_move
+////////////////////////////////
+
+namespace inplace_unique_move{
+
+holder_t make_small(int v)
+{
+   holder_t h;
+   h.emplace<Small>(v);
+   return boost::move(h);
+}
+
+void test()
+{
+   reset_counters();
+   {
+      holder_t h(make_small(5));
+      BOOST_TEST(h.is_inline());
+      BOOST_TEST(h->value() == 5);
+      BOOST_TEST(Base::count == 1);
+      //Inline objects are relocated
+      holder_t h2(boost::move(h));
+      BOOST_TEST(!h);
+      BOOST_TEST(!h.is_inline());
+      BOOST_TEST(h2.is_inline());
+      BOOST_TEST(h2->value() == 5);
+      BOOST_TEST(Base::count == 1);
+      BOOST_TEST(Small::moves >= 1);
+      //Heap objects are transferred
+      holder_t h3;
+      Big &b = h3.emplace<Big>(7, char(0));
+      h = boost::move(h3);
+      BOOST_TEST(!h3);
+      BOOST_TEST(h.get() == &b);
+      BOOST_TEST(Base::count == 2);
+      //Assignment destroys the previous object
+      h2 = boost::move(h);
+      BOOST_TEST(Base::count == 1);
+      BOOST_TEST(h2.get() == &b);
+      h2 = make_small(9);
+      BOOST_TEST(Base::count == 1);
+      BOOST_TEST(h2->value() == 9);
+      //Swap
+      h.emplace<Big>(1, char(1));
+      h.swap(h2);
+      BOOST_TEST(h->value() == 9);
+      BOOST_TEST(h.is_inline());
+      BOOST_TEST(h2->value() == 2);
+      BOOST_TEST(!h2.is_inline());
+      swap(h, h2);
+      BOOST_TEST(h->value() == 2);
+      BOOST_TEST(h2->value() == 9);
+      BOOST_TEST(Base::count == 2);
+      h = 0;
+      BOOST_TEST(Base::count == 1);
+   }
+   BOOST_TEST(Base::count == 0);
+}
+
+}  //namespace inplace_unique_move{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   inplace_unique_emplace::test();
+   inplace_unique_move::test();
+
+   //Test results
+   return boost::report_errors();
+}
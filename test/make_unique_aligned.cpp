@@ -0,0 +1,129 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/aligned_delete.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+
+namespace bml = ::boost::movelib;
+
+struct A
+{
+   static int count;
+   static int throw_at;
+   int v;
+   A() : v(7)
+   {
+      if(count == throw_at)
+         throw 0;
+      ++count;
+   }
+   ~A() {  --count;  }
+};
+
+int A::count = 0;
+int A::throw_at = -1;
+
+bool is_aligned(const void *p, std::size_t align)
+{  return !(reinterpret_cast<std::size_t>(p) & (align - 1u));  }
+
+////////////////////////////////
+//   make_unique_aligned_alignment
+////////////////////////////////
+
+namespace make_unique_aligned_alignment{
+
+void test()
+{
+   const std::size_t aligns[] = { 1, 8, 16, 32, 64, 128, 4096 };
+   for(std::size_t i = 0; i != sizeof(aligns)/sizeof(aligns[0]); ++i){
+      for(std::size_t n = 0; n != 5; ++n){
+         bml::unique_ptr<float[], bml::aligned_delete<float> > p
+            = bml::make_unique_aligned<float[]>(n*7 + 1, aligns[i]);
+         BOOST_TEST(is_aligned(p.get(), aligns[i]));
+         BOOST_TEST(p.get_deleter().size() == n*7 + 1);
+         BOOST_TEST(p.get_deleter().alignment() >= aligns[i]);
+         //Value initialized
+         for(std::size_t j = 0; j != n*7 + 1; ++j)
+            BOOST_TEST(p[j] == 0.0f);
+      }
+   }
+   {
+      bml::unique_ptr<double[], bml::aligned_delete<double> > p
+         = bml::make_unique_aligned_definit<double[]>(100, 64);
+      BOOST_TEST(is_aligned(p.get(), 64));
+      double *const d = bml::aligned_data<64>(p);
+      BOOST_TEST(d == p.get());
+      for(std::size_t j = 0; j != 100; ++j)
+         d[j] = double(j);
+      double sum = 0;
+      for(std::size_t j = 0; j != 100; ++j)
+         sum += d[j];
+      BOOST_TEST(sum == 4950.0);
+   }
+   {
+      //Empty arrays
+      bml::unique_ptr<int[], bml::aligned_delete<int> > p = bml::make_unique_aligned<int[]>(0, 32);
+      BOOST_TEST(p.get_deleter().size() == 0);
+      bml::unique_ptr<int[], bml::aligned_delete<int> > q;
+      BOOST_TEST(!q);
+      BOOST_TEST(!bml::aligned_data<16>(q));
+   }
+}
+
+}  //namespace make_unique_aligned_alignment{
+
+////////////////////////////////
+//   make_unique_aligned_objects
+////////////////////////////////
+
+namespace make_unique_aligned_objects{
+
+void test()
+{
+   A::count = 0;
+   {
+      bml::unique_ptr<A[], bml::aligned_delete<A> > p = bml::make_unique_aligned<A[]>(10, 64);
+      BOOST_TEST(A::count == 10);
+      BOOST_TEST(p[9].v == 7);
+      bml::unique_ptr<A[], bml::aligned_delete<A> > q(boost::move(p));
+      BOOST_TEST(!p);
+      BOOST_TEST(q.get_deleter().size() == 10);
+      BOOST_TEST(A::count == 10);
+   }
+   BOOST_TEST(A::count == 0);
+   //Construction failure destroys constructed elements
+   A::throw_at = 5;
+   bool thrown = false;
+   try{
+      bml::make_unique_aligned_definit<A[]>(10, 128);
+   }
+   catch(int){
+      thrown = true;
+   }
+   BOOST_TEST(thrown);
+   BOOST_TEST(A::count == 0);
+   A::throw_at = -1;
+}
+
+}  //namespace make_unique_aligned_objects{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   make_unique_aligned_alignment::test();
+   make_unique_aligned_objects::test();
+
+   //Test results
+   return boost::report_errors();
+}
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/make_unique.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+namespace bml = ::boost::movelib;
+
+////////////////////////////////
+//   make_unique_forward
+////////////////////////////////
+
+namespace make_unique_forward{
+
+class buffer
+{
+   BOOST_COPYABLE_AND_MOVABLE(buffer)
+
+   public:
+   static int copies;
+   static int moves;
+
+   buffer() {}
+   buffer(const buffer &) { ++copies; }
+   buffer(BOOST_RV_REF(buffer)) { ++moves; }
+   buffer& operator=(BOOST_COPY_ASSIGN_REF(buffer)) { ++copies; return *this; }
+   buffer& operator=(BOOST_RV_REF(buffer)) { ++moves; return *this; }
+};
+
+int buffer::copies = 0;
+int buffer::moves = 0;
+
+//Takes a non-const lvalue reference, which can't bind to const P & arguments
+struct sink
+{
+   sink(BOOST_RV_REF(buffer) b, int &out, int value)
+      : m_b(boost::move(b))
+   {  out = value;  }
+
+   sink(const buffer &b, int &out, int value)
+      : m_b(b)
+   {  out = value;  }
+
+   buffer m_b;
+};
+
+//More arguments than BOOST_MOVE_MAX_LVALUE_FORWARDING_PARAMETERS are taken by const reference
+struct many
+{
+   many(int a0, int a1, int a2, int a3, int a4, int a5, int a6, int a7, int a8, int a9)
+      : sum(a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9)
+   {}
+   int sum;
+};
+
+void test()
+{
+   buffer b;
+   const buffer cb;
+   int out = 0;
+   buffer::copies = buffer::moves = 0;
+   {
+   bml::unique_ptr<sink> p(bml::make_unique<sink>(boost::move(b), out, 1));
+   BOOST_TEST(buffer::copies == 0 && buffer::moves == 1);
+   BOOST_TEST(out == 1);
+   }
+   {
+   bml::unique_ptr<sink> p(bml::make_unique<sink>(cb, out, 2));
+   BOOST_TEST(buffer::copies == 1 && buffer::moves == 1);
+   BOOST_TEST(out == 2);
+   }
+   {
+   bml::unique_ptr<many> p(bml::make_unique<many>(1, 1, 1, 1, 1, 1, 1, 1, 1, out));
+   BOOST_TEST(p->sum == 11);
+   }
+}
+
+}  //namespace make_unique_forward{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   make_unique_forward::test();
+
+   //Test results
+   return boost::report_errors();
+}
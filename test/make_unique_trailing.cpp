@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/trailing_delete.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+
+namespace bml = ::boost::movelib;
+
+struct header
+{
+   static int count;
+   std::size_t len;
+   int a, b;
+   header() : len(0), a(-1), b(-1) {++count;}
+   header(std::size_t l, int x, int y) : len(l), a(x), b(y) {++count;}
+   ~header() {--count;}
+};
+
+int header::count = 0;
+
+struct elem
+{
+   static int count;
+   static int throw_on;
+   double d;
+   elem() : d(1.5)
+   {
+      if(count == throw_on)   throw int(0);
+      ++count;
+   }
+   ~elem() {--count;}
+};
+
+int elem::count = 0;
+int elem::throw_on = -1;
+
+void reset_counters()
+{  header::count = elem::count = 0; elem::throw_on = -1;  }
+
+////////////////////////////////
+//   make_unique_trailing_basic
+////////////////////////////////
+
+namespace make_unique_trailing_basic{
+
+void test()
+{
+   reset_counters();
+   {
+      typedef bml::unique_ptr<header, bml::trailing_delete<header, elem> > ptr_t;
+      ptr_t p(bml::make_unique_with_trailing<header, elem>(5, std::size_t(5), 1, 2));
+      BOOST_TEST(header::count == 1);
+      BOOST_TEST(elem::count == 5);
+      BOOST_TEST(p->len == 5);
+      BOOST_TEST(p->a == 1);
+      BOOST_TEST(p->b == 2);
+      BOOST_TEST(p.get_deleter().size() == 5);
+      elem *const e = bml::trailing_data(p);
+      //Elements follow the header in the same block, suitably aligned
+      BOOST_TEST(reinterpret_cast<char*>(e) >= reinterpret_cast<char*>(p.get()) + sizeof(header));
+      BOOST_TEST(reinterpret_cast<std::size_t>(e) % boost::move_upd::alignment_of<elem>::value == 0);
+      for(std::size_t i = 0; i != 5; ++i){
+         BOOST_TEST(e[i].d == 1.5);
+      }
+      //Ownership can be transferred
+      ptr_t p2(::boost::move(p));
+      BOOST_TEST(!p);
+      BOOST_TEST(p2.get_deleter().size() == 5);
+      BOOST_TEST(bml::trailing_data(p2) == e);
+   }
+   BOOST_TEST(header::count == 0);
+   BOOST_TEST(elem::count == 0);
+   //Default constructed header and no trailing elements
+   {
+      bml::unique_ptr<header, bml::trailing_delete<header, elem> > p
+         (bml::make_unique_with_trailing<header, elem>(0));
+      BOOST_TEST(header::count == 1);
+      BOOST_TEST(elem::count == 0);
+      BOOST_TEST(p->a == -1);
+   }
+   BOOST_TEST(header::count == 0);
+   //Default initialized payload
+   {
+      bml::unique_ptr<header, bml::trailing_delete<header, char> > p
+         (bml::make_unique_with_trailing_definit<header, char>(100, std::size_t(100), 0, 0));
+      char *const c = bml::trailing_data(p);
+      for(std::size_t i = 0; i != p->len; ++i){
+         c[i] = char(i);
+      }
+      BOOST_TEST(c[99] == char(99));
+   }
+   {
+      bml::unique_ptr<header, bml::trailing_delete<header, char> > p
+         (bml::make_unique_with_trailing<header, char>(8));
+      char *const c = bml::trailing_data(p);
+      for(std::size_t i = 0; i != 8; ++i){
+         BOOST_TEST(c[i] == 0);
+      }
+   }
+   BOOST_TEST(header::count == 0);
+}
+
+}  //namespace make_unique_trailing_basic{
+
+////////////////////////////////
+//   make_unique_trailing_throw
+////////////////////////////////
+
+namespace make_unique_trailing_throw{
+
+void test()
+{
+   reset_counters();
+   elem::throw_on = 3;
+   bool thrown = false;
+   try{
+      bml::make_unique_with_trailing<header, elem>(10);
+   }
+   catch(int){
+      thrown = true;
+   }
+   BOOST_TEST(thrown);
+   BOOST_TEST(header::count == 0);
+   BOOST_TEST(elem::count == 0);
+   reset_counters();
+   //Overflow
+   thrown = false;
+   try{
+      bml::make_unique_with_trailing<header, elem>(std::size_t(-1)/sizeof(elem));
+   }
+   catch(std::bad_alloc &){
+      thrown = true;
+   }
+   BOOST_TEST(thrown);
+   BOOST_TEST(header::count == 0);
+}
+
+}  //namespace make_unique_trailing_throw{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   make_unique_trailing_basic::test();
+   make_unique_trailing_throw::test();
+
+   //Test results
+   return boost::report_errors();
+}
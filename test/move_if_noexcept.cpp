@@ -11,6 +11,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #include <boost/move/detail/config_begin.hpp>
 #include <boost/move/utility.hpp>
+#include <boost/move/algorithm.hpp>
 #include <boost/core/lightweight_test.hpp>
 #include "../example/movable.hpp"
 #include "../example/copymovable.hpp"
@@ -53,6 +54,72 @@ struct has_nothrow_move<copy_movable_noexcept>
 
 }  //namespace boost{
 
+//////////////////////////////////////////////////////////////////////////////
+//A copy_movable_nothrow_marked class, marked instead of specializing has_nothrow_move
+class copy_movable_nothrow_marked
+{
+   BOOST_COPYABLE_AND_MOVABLE_NOTHROW(copy_movable_nothrow_marked)
+   int value_;
+
+   public:
+   copy_movable_nothrow_marked() : value_(1){}
+
+   //Move constructor and assignment
+   copy_movable_nothrow_marked(BOOST_RV_REF(copy_movable_nothrow_marked) m)
+   {  value_ = m.value_;   m.value_ = 0;  }
+
+   copy_movable_nothrow_marked(const copy_movable_nothrow_marked &m)
+   {  value_ = m.value_;   }
+
+   copy_movable_nothrow_marked & operator=(BOOST_RV_REF(copy_movable_nothrow_marked) m)
+   {  value_ = m.value_;   m.value_ = 0;  return *this;  }
+
+   copy_movable_nothrow_marked & operator=(BOOST_COPY_ASSIGN_REF(copy_movable_nothrow_marked) m)
+   {  value_ = m.value_;   return *this;  }
+
+   bool moved() const //Observer
+   {  return value_ == 0; }
+};
+
+//The marker is not inherited
+class copy_movable_derived
+   : public copy_movable_nothrow_marked
+{
+   BOOST_COPYABLE_AND_MOVABLE(copy_movable_derived)
+
+   public:
+   copy_movable_derived(){}
+
+   copy_movable_derived(BOOST_RV_REF(copy_movable_derived) m)
+      : copy_movable_nothrow_marked(boost::move(static_cast<copy_movable_nothrow_marked&>(m)))
+   {}
+
+   copy_movable_derived(const copy_movable_derived &m)
+      : copy_movable_nothrow_marked(m)
+   {}
+
+   copy_movable_derived & operator=(BOOST_RV_REF(copy_movable_derived) m)
+   {  copy_movable_nothrow_marked::operator=(boost::move(static_cast<copy_movable_nothrow_marked&>(m)));  return *this;  }
+
+   copy_movable_derived & operator=(BOOST_COPY_ASSIGN_REF(copy_movable_derived) m)
+   {  copy_movable_nothrow_marked::operator=(static_cast<const copy_movable_nothrow_marked&>(m));  return *this;  }
+};
+
+class movable_nothrow_marked
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE_NOTHROW(movable_nothrow_marked)
+
+   public:
+   movable_nothrow_marked(){}
+   movable_nothrow_marked(BOOST_RV_REF(movable_nothrow_marked)){}
+   movable_nothrow_marked & operator=(BOOST_RV_REF(movable_nothrow_marked)){  return *this;  }
+};
+
+BOOST_STATIC_ASSERT(( boost::has_nothrow_move<copy_movable_nothrow_marked>::value ));
+BOOST_STATIC_ASSERT(( boost::has_nothrow_move<const copy_movable_nothrow_marked>::value ));
+BOOST_STATIC_ASSERT(( boost::has_nothrow_move<movable_nothrow_marked>::value ));
+BOOST_STATIC_ASSERT(( !boost::has_nothrow_move<copy_movable_derived>::value ));
+
 //////////////////////////////////////////////////////////////////////////////
 //A movable_throwable class
 class movable_throwable
@@ -95,6 +162,11 @@ copy_movable_noexcept function(copy_movable_noexcept m)
    return copy_movable_noexcept(boost::move_if_noexcept(m));
 }
 
+copy_movable_nothrow_marked function(copy_movable_nothrow_marked m)
+{
+   return copy_movable_nothrow_marked(boost::move_if_noexcept(m));
+}
+
 movable_throwable function(movable_throwable m)
 {
    return movable_throwable(boost::move_if_noexcept(m));
@@ -128,6 +200,24 @@ movable move_return_function ()
 
 #define BOOST_CHECK(x) if (!(x)) { return __LINE__; }
 
+//Moves or copies a range with uninitialized_move_if_noexcept and checks
+//that the source was moved only if expected
+template<class T>
+bool uninitialized_move_if_noexcept_range(bool expect_moved)
+{
+   T src[3];
+   union { char raw[sizeof(T)*3]; double align; } storage;
+   T *const dst = reinterpret_cast<T*>(storage.raw);
+   if(boost::uninitialized_move_if_noexcept(src, src + 3, dst) != dst + 3)
+      return false;
+   bool ok = true;
+   for(int i = 0; i != 3; ++i){
+      ok = ok && src[i].moved() == expect_moved && !dst[i].moved();
+      dst[i].~T();
+   }
+   return ok;
+}
+
 int main()
 {
    {
@@ -212,6 +302,25 @@ int main()
       BOOST_CHECK(!m4.moved());
 	}
 
+   // copy_movable_nothrow_marked can not throw during move, declared with the _NOTHROW macro
+   {
+      copy_movable_nothrow_marked m;
+      copy_movable_nothrow_marked m2(boost::move_if_noexcept(m));
+      BOOST_CHECK(m.moved());
+      copy_movable_nothrow_marked m3(function(copy_movable_nothrow_marked(boost::move_if_noexcept(m2))));
+      BOOST_CHECK(m2.moved());
+      copy_movable_nothrow_marked m4(function(boost::move_if_noexcept(m3)));
+      BOOST_CHECK(m3.moved());
+      BOOST_CHECK(!m4.moved());
+	}
+
+   // copy_movable_derived does not inherit the marker, so it must be copied
+   {
+      copy_movable_derived m;
+      copy_movable_derived m2(boost::move_if_noexcept(m));
+      BOOST_CHECK(!m.moved());
+	}
+
    // movable_throwable can not throw during move but it has no copy constructor
    {
       movable_throwable m;
@@ -224,6 +333,26 @@ int main()
       BOOST_CHECK(!m4.moved());
 	}
 
+   // uninitialized_move_if_noexcept moves the range only if the move can't throw
+   {
+      BOOST_CHECK(uninitialized_move_if_noexcept_range<movable>(true));
+      BOOST_CHECK(uninitialized_move_if_noexcept_range<copy_movable>(false));
+      BOOST_CHECK(uninitialized_move_if_noexcept_range<copy_movable_noexcept>(true));
+      BOOST_CHECK(uninitialized_move_if_noexcept_range<copy_movable_nothrow_marked>(true));
+      BOOST_CHECK(uninitialized_move_if_noexcept_range<copy_movable_derived>(false));
+      BOOST_CHECK(uninitialized_move_if_noexcept_range<movable_throwable>(true));
+   }
+
+   // trivially copyable ranges are copied with memcpy
+   {
+      const int src[3] = { 1, 2, 3 };
+      int dst[3] = { 0, 0, 0 };
+      BOOST_CHECK(boost::uninitialized_move_if_noexcept(&src[0], &src[0] + 3, &dst[0]) == &dst[0] + 3);
+      BOOST_CHECK(dst[0] == 1 && dst[1] == 2 && dst[2] == 3);
+      int *const p = &dst[0];
+      BOOST_CHECK(boost::uninitialized_move_if_noexcept(p, p, p + 1) == p + 1);
+   }
+
    return boost::report_errors();
 }
 
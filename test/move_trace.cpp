@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#define BOOST_MOVE_ENABLE_TRACE
+#include <boost/move/utility_core.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdio>
+
+class tracked
+{
+   BOOST_COPYABLE_AND_MOVABLE(tracked)
+   public:
+   tracked()
+   {}
+
+   tracked(const tracked &)
+   {  BOOST_MOVE_TRACE_COPY_CONSTRUCT(tracked);  }
+
+   tracked(BOOST_RV_REF(tracked))
+   {  BOOST_MOVE_TRACE_MOVE_CONSTRUCT(tracked);  }
+
+   tracked& operator=(BOOST_COPY_ASSIGN_REF(tracked))
+   {  BOOST_MOVE_TRACE_COPY_ASSIGN(tracked); return *this;  }
+
+   tracked& operator=(BOOST_RV_REF(tracked))
+   {  BOOST_MOVE_TRACE_MOVE_ASSIGN(tracked); return *this;  }
+};
+
+//No hooks, only what the emulation sees is counted
+class untracked
+{
+   BOOST_COPYABLE_AND_MOVABLE(untracked)
+   public:
+   untracked()
+   {}
+
+   untracked(const untracked &)
+   {}
+
+   untracked(BOOST_RV_REF(untracked))
+   {}
+
+   untracked& operator=(BOOST_COPY_ASSIGN_REF(untracked))
+   {  return *this;  }
+
+   untracked& operator=(BOOST_RV_REF(untracked))
+   {  return *this;  }
+};
+
+tracked make()
+{  return tracked();  }
+
+template<class U>
+void sink(BOOST_FWD_REF(U) u)
+{  tracked t(boost::forward<U>(u));  }
+
+////////////////////////////////
+//   move_trace_counters
+////////////////////////////////
+
+namespace move_trace_counters{
+
+void test()
+{
+   boost::move_trace_reset();
+   boost::move_trace_counts c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.copy_constructions == 0 && c.move_constructions == 0 && c.rvalue_casts == 0);
+   tracked a;
+   tracked b(boost::move(a));
+   tracked d(b);
+   d = b;
+   d = boost::move(b);
+   c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.copy_constructions == 1);
+   BOOST_TEST(c.move_constructions == 1);
+   BOOST_TEST(c.copy_assignments == 1);
+   BOOST_TEST(c.move_assignments == 1);
+   BOOST_TEST(c.rvalue_casts == 2);
+
+   //Assignment from a temporary
+   d = make();
+   c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.copy_assignments == 1);
+   BOOST_TEST(c.move_assignments == 2);
+   #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   //The emulation converts the temporary to rv<tracked>&
+   BOOST_TEST(c.rvalue_casts == 3);
+   #else
+   //Implicit moves are not traced
+   BOOST_TEST(c.rvalue_casts == 2);
+   #endif
+
+   //Forwarding
+   boost::move_trace_reset();
+   sink(a);
+   c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.copy_constructions == 1);
+   BOOST_TEST(c.rvalue_casts == 0);
+   //boost::forward preserves the rvalue produced by boost::move, one move counts once
+   sink(boost::move(a));
+   c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.move_constructions == 1);
+   BOOST_TEST(c.rvalue_casts == 1);
+   //Moving an rvalue again is not counted
+   tracked e(boost::move(boost::move(a)));
+   c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.move_constructions == 2);
+   BOOST_TEST(c.rvalue_casts == 2);
+}
+
+}  //namespace move_trace_counters{
+
+////////////////////////////////
+//   move_trace_copy_assign
+////////////////////////////////
+
+namespace move_trace_copy_assign{
+
+void test()
+{
+   boost::move_trace_reset();
+   //Non-const lvalues are counted once, by the emulation in C++03
+   //and by the hook otherwise. Const lvalues are counted by the hook
+   tracked a, b;
+   const tracked ca;
+   a = b;
+   a = ca;
+   boost::move_trace_counts c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.copy_assignments == 2);
+   BOOST_TEST(c.copy_constructions == 0 && c.move_constructions == 0 && c.move_assignments == 0);
+
+   //Without hooks only copy assignments from non-const lvalues in C++03 are counted
+   untracked u, v;
+   const untracked cu;
+   u = v;
+   u = cu;
+   c = boost::move_trace_counts_of<untracked>();
+   #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   BOOST_TEST(c.copy_assignments == 1);
+   #else
+   BOOST_TEST(c.copy_assignments == 0);
+   #endif
+   BOOST_TEST(c.copy_constructions == 0 && c.move_constructions == 0 && c.move_assignments == 0);
+}
+
+}  //namespace move_trace_copy_assign{
+
+////////////////////////////////
+//   move_trace_dump
+////////////////////////////////
+
+namespace move_trace_dump{
+
+void test()
+{
+   //Non-class types are not traced
+   int i = 0;
+   int j = boost::move(i);
+   (void)j;
+   std::FILE *const f = std::tmpfile();
+   if(f){
+      #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+      BOOST_TEST(boost::move_trace_dump(f) == 2u);
+      #else
+      BOOST_TEST(boost::move_trace_dump(f) == 1u);
+      #endif
+      std::fclose(f);
+   }
+   boost::move_trace_reset();
+   boost::move_trace_counts c = boost::move_trace_counts_of<tracked>();
+   BOOST_TEST(c.copy_constructions == 0 && c.move_constructions == 0);
+   BOOST_TEST(c.copy_assignments == 0 && c.move_assignments == 0 && c.rvalue_casts == 0);
+}
+
+}  //namespace move_trace_dump{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   move_trace_counters::test();
+   move_trace_copy_assign::test();
+   move_trace_dump::test();
+
+   //Test results
+   return boost::report_errors();
+}
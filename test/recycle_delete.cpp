@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/recycle_delete.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <vector>
+
+namespace bml = ::boost::movelib;
+
+namespace msg_ns{
+
+struct message
+{
+   static int constructed;
+   static int count;
+   static int resets;
+   std::vector<char> buffer;
+   int id;
+
+   message() : buffer(), id(0) {++constructed; ++count;}
+   ~message() {--count;}
+};
+
+int message::constructed = 0;
+int message::count = 0;
+int message::resets = 0;
+
+//Found by ADL from recycle_reset
+void reset(message &m)
+{
+   ++message::resets;
+   m.buffer.clear();
+   m.id = 0;
+}
+
+}  //namespace msg_ns{
+
+using msg_ns::message;
+
+void reset_counters()
+{  message::constructed = message::count = message::resets = 0;  }
+
+////////////////////////////////
+//   recycle_delete_reuse
+////////////////////////////////
+
+namespace recycle_delete_reuse{
+
+void test()
+{
+   reset_counters();
+   {
+      typedef bml::recycle_pool<message> pool_t;
+      pool_t pool;
+      message *first = 0;
+      {
+         pool_t::unique_ptr_type m(pool.acquire());
+         BOOST_TEST(message::constructed == 1);
+         BOOST_TEST(m.get_deleter().pool() == &pool);
+         m->buffer.resize(1000);
+         m->id = 1;
+         first = m.get();
+      }
+      //Returned and reset, not destroyed
+      BOOST_TEST(message::count == 1);
+      BOOST_TEST(message::resets == 1);
+      BOOST_TEST(pool.free_count() == 1u);
+      //Steady state reuses the object and its buffer
+      for(int i = 0; i != 100; ++i){
+         pool_t::unique_ptr_type m(pool.acquire());
+         BOOST_TEST(m.get() == first);
+         BOOST_TEST(m->id == 0);
+         BOOST_TEST(m->buffer.empty());
+         BOOST_TEST(m->buffer.capacity() >= 1000u);
+         m->buffer.resize(1000);
+      }
+      BOOST_TEST(message::constructed == 1);
+      BOOST_TEST(message::resets == 101);
+      //Unique ownership can be transferred
+      {
+         pool_t::unique_ptr_type m(pool.acquire());
+         pool_t::unique_ptr_type m2(::boost::move(m));
+         BOOST_TEST(!m);
+         BOOST_TEST(m2.get() == first);
+      }
+      BOOST_TEST(pool.free_count() == 1u);
+   }
+   //The pool destroys its free list
+   BOOST_TEST(message::count == 0);
+}
+
+}  //namespace recycle_delete_reuse{
+
+////////////////////////////////
+//   recycle_delete_limits
+////////////////////////////////
+
+namespace recycle_delete_limits{
+
+struct counting_reset
+{
+   int *calls;
+   explicit counting_reset(int *c) : calls(c) {}
+   void operator()(message &m) const
+   {  ++*calls; m.buffer.clear();  }
+};
+
+void test()
+{
+   reset_counters();
+   int calls = 0;
+   {
+      typedef bml::recycle_pool<message, counting_reset> pool_t;
+      pool_t pool(2, counting_reset(&calls));
+      pool.reserve(5);
+      BOOST_TEST(pool.free_count() == 2u);
+      BOOST_TEST(message::constructed == 2);
+      {
+         pool_t::unique_ptr_type a(pool.acquire());
+         pool_t::unique_ptr_type b(pool.acquire());
+         pool_t::unique_ptr_type c(pool.acquire());
+         BOOST_TEST(pool.free_count() == 0u);
+         BOOST_TEST(message::constructed == 3);
+      }
+      //Only two fit in the free list, the third one is destroyed
+      BOOST_TEST(pool.free_count() == 2u);
+      BOOST_TEST(message::count == 2);
+      BOOST_TEST(calls == 2);
+      pool.shrink_to(0);
+      BOOST_TEST(message::count == 0);
+   }
+   //A deleter without pool deletes
+   {
+      bml::unique_ptr<message, bml::recycle_delete<message> > m(new message);
+      BOOST_TEST(message::count == 1);
+   }
+   BOOST_TEST(message::count == 0);
+}
+
+}  //namespace recycle_delete_limits{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   recycle_delete_reuse::test();
+   recycle_delete_limits::test();
+
+   //Test results
+   return boost::report_errors();
+}
@@ -0,0 +1,252 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/slab_delete.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#if defined(BOOST_MOVE_HAS_SLAB_DELETE)
+
+#include <atomic>
+#include <thread>
+#include <cstddef>
+
+namespace bml = ::boost::movelib;
+
+struct A
+{
+   static std::atomic<int> count;
+   int value;
+   explicit A(int v = 0) : value(v) {++count;}
+   virtual ~A() {--count;}
+};
+
+std::atomic<int> A::count(0);
+
+struct B : A
+{
+   double d;
+   explicit B(int v) : A(v), d(1.0) {}
+};
+
+struct Throwing
+{
+   explicit Throwing(bool t) { if(t) throw 0; }
+};
+
+bool is_aligned(const void *p, std::size_t align)
+{  return !(reinterpret_cast<std::size_t>(p) & (align - 1u));  }
+
+typedef bml::unique_ptr<A, bml::slab_delete<A> > ptr_t;
+
+////////////////////////////////
+//   slab_delete_local
+////////////////////////////////
+
+namespace slab_delete_local{
+
+void test()
+{
+   BOOST_STATIC_ASSERT(sizeof(ptr_t) == sizeof(A*));
+   A::count = 0;
+   {
+      ptr_t p = bml::make_unique_slab<A>(3);
+      BOOST_TEST(A::count == 1);
+      BOOST_TEST(p->value == 3);
+      BOOST_TEST(is_aligned(p.get(), ::boost::move_upd::alignment_of< ::boost::move_upd::max_align_t>::value));
+      A *const addr = p.get();
+      p.reset();
+      BOOST_TEST(A::count == 0);
+      //The block is reused
+      p = bml::make_unique_slab<A>(4);
+      BOOST_TEST(p.get() == addr);
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      //Many objects, more than a slab
+      const std::size_t N = 5000;
+      static ptr_t v[N];
+      for(std::size_t i = 0; i != N; ++i){
+         v[i] = bml::make_unique_slab<A>(int(i));
+      }
+      BOOST_TEST(A::count == int(N));
+      for(std::size_t i = 0; i != N; ++i){
+         BOOST_TEST(v[i]->value == int(i));
+         v[i].reset();
+      }
+      BOOST_TEST(A::count == 0);
+   }
+   {
+      //Converting to a base class
+      ptr_t p(bml::make_unique_slab<B>(5));
+      BOOST_TEST(A::count == 1);
+      BOOST_TEST(p->value == 5);
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      //A throwing constructor returns the block
+      bml::unique_ptr<Throwing, bml::slab_delete<Throwing> > p = bml::make_unique_slab<Throwing>(false);
+      Throwing *const addr = p.get();
+      p.reset();
+      bool thrown = false;
+      try{
+         bml::make_unique_slab<Throwing>(true);
+      }
+      catch(int){
+         thrown = true;
+      }
+      BOOST_TEST(thrown);
+      p = bml::make_unique_slab<Throwing>(false);
+      BOOST_TEST(p.get() == addr);
+   }
+}
+
+}  //namespace slab_delete_local{
+
+////////////////////////////////
+//   slab_delete_remote
+////////////////////////////////
+
+namespace slab_delete_remote{
+
+void test()
+{
+   A::count = 0;
+   const std::size_t N = 100;
+   static ptr_t v[N];
+   A *addrs[N];
+   for(std::size_t i = 0; i != N; ++i){
+      v[i] = bml::make_unique_slab<A>(int(i));
+      addrs[i] = v[i].get();
+   }
+   //Nothing to reclaim yet
+   BOOST_TEST(bml::slab_delete<A>::reclaim() == 0u);
+   //The consumer destroys the objects, which are returned to the producer's heap
+   std::thread consumer([&]{
+      for(std::size_t i = 0; i != N; ++i){
+         v[i].reset();
+      }
+   });
+   consumer.join();
+   BOOST_TEST(A::count == 0);
+   BOOST_TEST(bml::slab_delete<A>::reclaim() == N);
+   //Reclaimed blocks are reused
+   ptr_t p = bml::make_unique_slab<A>();
+   bool found = false;
+   for(std::size_t i = 0; i != N; ++i){
+      found = found || addrs[i] == p.get();
+   }
+   BOOST_TEST(found);
+}
+
+}  //namespace slab_delete_remote{
+
+////////////////////////////////
+//   slab_delete_orphan
+////////////////////////////////
+
+namespace slab_delete_orphan{
+
+//Own size class, not used by other tests
+struct C
+{
+   char data[200];
+};
+
+typedef bml::unique_ptr<C, bml::slab_delete<C> > c_ptr_t;
+
+void test()
+{
+   const std::size_t N = 10;
+   static c_ptr_t v[N];
+   //The producer exits while its objects are alive
+   std::thread producer([&]{
+      for(std::size_t i = 0; i != N; ++i){
+         v[i] = bml::make_unique_slab<C>();
+      }
+   });
+   producer.join();
+   for(std::size_t i = 0; i != N; ++i){
+      v[i].reset();
+   }
+   //The next thread adopts the orphaned heap and the blocks freed after the producer exited
+   std::size_t reclaimed = 0;
+   std::thread adopter([&]{
+      reclaimed = bml::slab_delete<C>::reclaim();
+   });
+   adopter.join();
+   BOOST_TEST(reclaimed == N);
+}
+
+}  //namespace slab_delete_orphan{
+
+////////////////////////////////
+//   slab_delete_concurrent
+////////////////////////////////
+
+namespace slab_delete_concurrent{
+
+void test()
+{
+   A::count = 0;
+   const std::size_t N = 20000;
+   const std::size_t Capacity = 64;
+   A *ring[Capacity];
+   std::atomic<std::size_t> head(0), tail(0);
+   std::atomic<int> sum(0);
+
+   std::thread consumer([&]{
+      for(std::size_t i = 0; i != N; ++i){
+         while(tail.load(std::memory_order_acquire) == head.load(std::memory_order_relaxed)){
+            std::this_thread::yield();
+         }
+         ptr_t p(ring[head.load(std::memory_order_relaxed) % Capacity]);
+         head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+         sum += p->value;
+      }
+   });
+   for(std::size_t i = 0; i != N; ++i){
+      ptr_t p = bml::make_unique_slab<A>(1);
+      while(tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) == Capacity){
+         std::this_thread::yield();
+      }
+      ring[tail.load(std::memory_order_relaxed) % Capacity] = p.release();
+      tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+   }
+   consumer.join();
+   BOOST_TEST(sum == int(N));
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace slab_delete_concurrent{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   slab_delete_local::test();
+   slab_delete_remote::test();
+   slab_delete_orphan::test();
+   slab_delete_concurrent::test();
+
+   //Test results
+   return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+   return boost::report_errors();
+}
+
+#endif
@@ -0,0 +1,226 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/unique_array.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdlib>
+#include <new>
+
+struct A
+{
+   int a;
+   static int count;
+   static int throw_on;
+   A() : a(999)
+   {
+      if(count == throw_on)   throw int(0);
+      ++count;
+   }
+   ~A() {--count;}
+};
+
+int A::count = 0;
+int A::throw_on = -1;
+
+void reset_counters()
+{  A::count = 0; A::throw_on = -1;  }
+
+#if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
+std::size_t last_sized_delete = 0;
+
+//std::malloc/std::free are called from non-inlined helpers: once the replaced
+//functions are inlined g++ sees std::free called on the result of operator new[]
+//and warns with -Wmismatched-new-delete
+BOOST_NOINLINE void *array_malloc(std::size_t sz)
+{  return std::malloc(sz ? sz : 1u);  }
+
+BOOST_NOINLINE void array_free(void *p)
+{  std::free(p);  }
+
+//The whole array allocation family is replaced so that the unsized and
+//sized deallocation functions are defined together and can use std::free
+void *operator new[](std::size_t sz)
+{
+   void *const p = array_malloc(sz);
+   if(!p)   throw std::bad_alloc();
+   return p;
+}
+
+void operator delete[](void *p) BOOST_NOEXCEPT
+{  array_free(p);  }
+
+void operator delete[](void *p, std::size_t sz) BOOST_NOEXCEPT
+{  last_sized_delete = sz; array_free(p);  }
+
+#endif   //#if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
+namespace bml = ::boost::movelib;
+
+////////////////////////////////
+//   unique_array_make
+////////////////////////////////
+
+namespace unique_array_make{
+
+void test()
+{
+   reset_counters();
+   {
+      bml::unique_array<A> p(bml::make_unique_array<A>(10));
+      BOOST_TEST(A::count == 10);
+      BOOST_TEST(p.size() == 10);
+      BOOST_TEST(!p.empty());
+      BOOST_TEST(!!p);
+      BOOST_TEST(p.data() == p.get());
+      BOOST_TEST(p.end() - p.begin() == 10);
+      for(bml::unique_array<A>::iterator it = p.begin(); it != p.end(); ++it){
+         BOOST_TEST(it->a == 999);
+      }
+      p[3].a = 3;
+      BOOST_TEST(p.get()[3].a == 3);
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      bml::unique_array<int> p(bml::make_unique_array<int>(5));
+      BOOST_TEST(p.size() == 5);
+      for(std::size_t i = 0; i != p.size(); ++i){
+         BOOST_TEST(p[i] == 0);
+      }
+   }
+   {
+      bml::unique_array<int> p(bml::make_unique_array_definit<int>(5));
+      BOOST_TEST(p.size() == 5);
+   }
+   {
+      bml::unique_array<A> p(bml::make_unique_array<A>(0));
+      BOOST_TEST(p.size() == 0);
+      BOOST_TEST(p.begin() == p.end());
+   }
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace unique_array_make{
+
+////////////////////////////////
+//   unique_array_make_throw
+////////////////////////////////
+
+namespace unique_array_make_throw{
+
+void test()
+{
+   reset_counters();
+   A::throw_on = 5;
+   bool thrown = false;
+   try{
+      bml::unique_array<A> p(bml::make_unique_array<A>(10));
+   }
+   catch(int){
+      thrown = true;
+   }
+   BOOST_TEST(thrown);
+   BOOST_TEST(A::count == 0);
+   reset_counters();
+}
+
+}  //namespace unique_array_make_throw{
+
+////////////////////////////////
+//   unique_array_move
+////////////////////////////////
+
+namespace unique_array_move{
+
+bml::unique_array<A> source(std::size_t n)
+{  return bml::make_unique_array<A>(n);  }
+
+void test()
+{
+   reset_counters();
+   {
+      bml::unique_array<A> p(source(4));
+      A *const ptr = p.get();
+      bml::unique_array<A> p2(::boost::move(p));
+      BOOST_TEST(A::count == 4);
+      BOOST_TEST(!p);
+      BOOST_TEST(p.size() == 0);
+      BOOST_TEST(p2.get() == ptr);
+      BOOST_TEST(p2.size() == 4);
+      p = source(2);
+      BOOST_TEST(A::count == 6);
+      p2 = ::boost::move(p);
+      BOOST_TEST(A::count == 2);
+      BOOST_TEST(p2.size() == 2);
+      BOOST_TEST(p.size() == 0);
+      p.swap(p2);
+      BOOST_TEST(p.size() == 2);
+      BOOST_TEST(p2.size() == 0);
+      p.reset();
+      BOOST_TEST(A::count == 0);
+      BOOST_TEST(p.size() == 0);
+      BOOST_TEST(!p.get());
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      bml::unique_array<A> p(source(3));
+      bml::unique_ptr<A[], bml::sized_array_delete<A> > up(p.release_unique_ptr());
+      BOOST_TEST(A::count == 3);
+      BOOST_TEST(!p);
+      BOOST_TEST(p.size() == 0);
+      BOOST_TEST(up.get_deleter().size() == 3);
+      bml::unique_array<A> p2(::boost::move(up));
+      BOOST_TEST(p2.size() == 3);
+      BOOST_TEST(!up);
+   }
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace unique_array_move{
+
+////////////////////////////////
+//   unique_array_sized_delete
+////////////////////////////////
+
+namespace unique_array_sized_delete{
+
+void test()
+{
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   reset_counters();
+   last_sized_delete = 0;
+   {
+      bml::unique_array<A> p(bml::make_unique_array<A>(7));
+   }
+   BOOST_TEST(last_sized_delete == 7*sizeof(A));
+   last_sized_delete = 0;
+   {
+      bml::unique_array<double> p(bml::make_unique_array_definit<double>(3));
+   }
+   BOOST_TEST(last_sized_delete == 3*sizeof(double));
+   #endif   //#if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+}
+
+}  //namespace unique_array_sized_delete{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   unique_array_make::test();
+   unique_array_make_throw::test();
+   unique_array_move::test();
+   unique_array_sized_delete::test();
+
+   //Test results
+   return boost::report_errors();
+}
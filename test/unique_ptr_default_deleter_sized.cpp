@@ -0,0 +1,235 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#define BOOST_MOVE_USE_SIZED_DEALLOCATION
+#include <boost/move/default_delete.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdlib>
+#include <new>
+
+namespace bml = ::boost::movelib;
+
+std::size_t last_sized_delete = 0;
+int class_delete_calls = 0;
+
+#if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
+//The whole allocation family is replaced so that the unsized and
+//sized deallocation functions are defined together and can use std::free
+void *operator new(std::size_t sz)
+{
+   void *const p = std::malloc(sz ? sz : 1u);
+   if(!p)   throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) BOOST_NOEXCEPT
+{  std::free(p);  }
+
+void operator delete(void *p, std::size_t sz) BOOST_NOEXCEPT
+{  last_sized_delete = sz; std::free(p);  }
+
+#if defined(BOOST_MOVE_HAS_ALIGNED_NEW)
+
+std::size_t last_aligned_sized_delete = 0;
+
+//Stores the address returned by malloc just before the aligned block
+void *operator new(std::size_t sz, std::align_val_t al)
+{
+   const std::size_t a = static_cast<std::size_t>(al);
+   char *const raw = static_cast<char*>(std::malloc(sz + a));
+   if(!raw)   throw std::bad_alloc();
+   char *const p = raw + (a - (reinterpret_cast<std::size_t>(raw) & (a - 1u)));
+   reinterpret_cast<char**>(p)[-1] = raw;
+   return p;
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{  if(p) std::free(static_cast<char**>(p)[-1]);  }
+
+void operator delete(void *p, std::size_t sz, std::align_val_t al) noexcept
+{  last_aligned_sized_delete = sz; ::operator delete(p, al);  }
+
+struct alignas(4*__STDCPP_DEFAULT_NEW_ALIGNMENT__) O
+{
+   static int count;
+   int data[2];
+   O() {++count;}
+   ~O() {--count;}
+};
+
+int O::count = 0;
+
+#endif   //#if defined(BOOST_MOVE_HAS_ALIGNED_NEW)
+
+#endif   //#if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+
+struct A
+{
+   static int count;
+   int data[3];
+   A() {++count;}
+   ~A() {--count;}
+};
+
+int A::count = 0;
+
+struct V
+{
+   static int count;
+   V() {++count;}
+   virtual ~V() {--count;}
+};
+
+int V::count = 0;
+
+struct D
+   : public V
+{
+   int data[5];
+};
+
+#if !defined(BOOST_NO_CXX11_FINAL)
+
+struct F final
+   : public V
+{
+   int data[7];
+};
+
+#endif   //#if !defined(BOOST_NO_CXX11_FINAL)
+
+struct C
+{
+   static int count;
+   C() {++count;}
+   ~C() {--count;}
+
+   static void *operator new(std::size_t sz)
+   {  return std::malloc(sz);  }
+
+   static void operator delete(void *p)
+   {  ++class_delete_calls; std::free(p);  }
+};
+
+int C::count = 0;
+
+void reset_counters()
+{  A::count = V::count = C::count = 0; last_sized_delete = 0; class_delete_calls = 0;  }
+
+////////////////////////////////
+//   unique_ptr_dltr_dflt_sized
+////////////////////////////////
+
+namespace unique_ptr_dltr_dflt_sized{
+
+void test()
+{
+   //Non-polymorphic type
+   {
+   reset_counters();
+   bml::default_delete<A> d;
+   A* p = new A;
+   BOOST_TEST(A::count == 1);
+   d(p);
+   BOOST_TEST(A::count == 0);
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   BOOST_TEST(last_sized_delete == sizeof(A));
+   #endif
+   }
+   //Const non-polymorphic type
+   {
+   reset_counters();
+   bml::default_delete<const A> d;
+   const A* p = new const A;
+   BOOST_TEST(A::count == 1);
+   d(p);
+   BOOST_TEST(A::count == 0);
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   BOOST_TEST(last_sized_delete == sizeof(A));
+   #endif
+   }
+   //Polymorphic type deleted through the base: the size of
+   //the dynamic type must reach the deallocation function
+   {
+   reset_counters();
+   bml::default_delete<V> d;
+   V* p = new D;
+   BOOST_TEST(V::count == 1);
+   d(p);
+   BOOST_TEST(V::count == 0);
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   BOOST_TEST(last_sized_delete == 0 || last_sized_delete == sizeof(D));
+   #endif
+   }
+   #if !defined(BOOST_NO_CXX11_FINAL)
+   //Final polymorphic type
+   {
+   reset_counters();
+   bml::default_delete<F> d;
+   F* p = new F;
+   BOOST_TEST(V::count == 1);
+   d(p);
+   BOOST_TEST(V::count == 0);
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION)
+   BOOST_TEST(last_sized_delete == sizeof(F));
+   #endif
+   }
+   #endif   //#if !defined(BOOST_NO_CXX11_FINAL)
+   //Class-specific operator delete must be honored
+   {
+   reset_counters();
+   bml::default_delete<C> d;
+   C* p = new C;
+   BOOST_TEST(C::count == 1);
+   d(p);
+   BOOST_TEST(C::count == 0);
+   BOOST_TEST(class_delete_calls == 1);
+   BOOST_TEST(last_sized_delete == 0);
+   }
+   #if defined(BOOST_MOVE_HAS_SIZED_DEALLOCATION) && defined(BOOST_MOVE_HAS_ALIGNED_NEW)
+   //Over-aligned types must be freed with the alignment
+   {
+   reset_counters();
+   last_aligned_sized_delete = 0;
+   bml::default_delete<O> d;
+   O* p = new O;
+   BOOST_TEST(O::count == 1);
+   BOOST_TEST(!(reinterpret_cast<std::size_t>(p) % alignof(O)));
+   d(p);
+   BOOST_TEST(O::count == 0);
+   BOOST_TEST(last_sized_delete == 0);
+   BOOST_TEST(last_aligned_sized_delete == sizeof(O));
+   }
+   #endif
+   //Arrays are not affected
+   {
+   reset_counters();
+   bml::default_delete<A[]> d;
+   A* p = new A[3];
+   BOOST_TEST(A::count == 3);
+   d(p);
+   BOOST_TEST(A::count == 0);
+   }
+}
+
+}  //namespace unique_ptr_dltr_dflt_sized{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   unique_ptr_dltr_dflt_sized::test();
+
+   //Test results
+   return boost::report_errors();
+}
@@ -0,0 +1,176 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/fn_deleter.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/unique_array.hpp>
+#include <boost/move/deferred_delete.hpp>
+#include <boost/move/epoch_delete.hpp>
+#include <boost/move/recycle_delete.hpp>
+#include <boost/move/trailing_delete.hpp>
+#include <boost/move/aligned_delete.hpp>
+#include <boost/move/unique_resource.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdlib>
+#include <cstdio>
+#include <cstddef>
+
+namespace bml = ::boost::movelib;
+
+struct A
+{
+   static int count;
+   A()  {  ++count;  }
+   ~A() {  --count;  }
+};
+
+int A::count = 0;
+
+//Used by recycle_pool<A>
+void reset(A &)
+{}
+
+void destroy_a(A *p)
+{  delete p;  }
+
+int g_released = 0;
+
+int release_handle(int)
+{  return ++g_released;  }
+
+////////////////////////////////
+//   unique_ptr_deleter_size_stateless
+////////////////////////////////
+
+namespace unique_ptr_deleter_size_stateless{
+
+typedef bml::fn_deleter<void(*)(A*), &destroy_a>            a_deleter;
+typedef bml::fn_deleter<void(*)(void*), &std::free>         free_deleter;
+typedef bml::fn_deleter<int(*)(std::FILE*), &std::fclose>   fclose_deleter;
+
+//Stateless deleters must not make unique_ptr bigger than a pointer
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A>) == sizeof(A*));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A[]>) == sizeof(A*));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A, a_deleter>) == sizeof(A*));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<char, free_deleter>) == sizeof(char*));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<std::FILE, fclose_deleter>) == sizeof(std::FILE*));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A, bml::deferred_delete<A> >) == sizeof(A*));
+#if defined(BOOST_MOVE_HAS_EPOCH_DELETE)
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A, bml::epoch_delete<A> >) == sizeof(A*));
+#endif
+#if defined(BOOST_MOVE_HAS_AUTO_NONTYPE_TEMPLATE_PARAMETERS)
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A, bml::function_deleter<&destroy_a> >) == sizeof(A*));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<std::FILE, bml::function_deleter<&std::fclose> >) == sizeof(std::FILE*));
+#endif
+
+//Function pointer deleters are stored
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A, void(*)(A*)>) == 2*sizeof(A*));
+
+//Also for other owners
+typedef bml::fn_deleter<int(*)(int), &release_handle> handle_deleter;
+BOOST_STATIC_ASSERT(sizeof(bml::unique_resource<int, handle_deleter, bml::invalid_value_sentinel<int, -1> >) == sizeof(int));
+
+void test()
+{
+   A::count = 0;
+   {
+      bml::unique_ptr<A, a_deleter> p(new A);
+      BOOST_TEST(A::count == 1);
+      bml::unique_ptr<A, a_deleter> p2(boost::move(p));
+      BOOST_TEST(!p);
+      p2.reset(new A);
+      BOOST_TEST(A::count == 1);
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      bml::unique_ptr<char, free_deleter> p(static_cast<char*>(std::malloc(16u)));
+      BOOST_TEST(!!p);
+   }
+   #if defined(BOOST_MOVE_HAS_AUTO_NONTYPE_TEMPLATE_PARAMETERS)
+   {
+      bml::unique_ptr<A, bml::function_deleter<&destroy_a> > p(new A);
+      BOOST_TEST(A::count == 1);
+   }
+   BOOST_TEST(A::count == 0);
+   #endif
+   g_released = 0;
+   {
+      bml::unique_resource<int, handle_deleter, bml::invalid_value_sentinel<int, -1> > h(0);
+      bml::unique_resource<int, handle_deleter, bml::invalid_value_sentinel<int, -1> > h2;
+      BOOST_TEST(!!h && !h2);
+   }
+   BOOST_TEST(g_released == 1);
+}
+
+}  //namespace unique_ptr_deleter_size_stateless{
+
+////////////////////////////////
+//   unique_ptr_deleter_size_stateful
+////////////////////////////////
+
+namespace unique_ptr_deleter_size_stateful{
+
+//Stateful deleters only add their state
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A[], bml::sized_array_delete<A> >) == sizeof(A*) + sizeof(std::size_t));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A, bml::recycle_delete<A> >) == 2*sizeof(A*));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A, bml::trailing_delete<A, int> >) == sizeof(A*) + sizeof(std::size_t));
+BOOST_STATIC_ASSERT(sizeof(bml::unique_ptr<A[], bml::aligned_delete<A> >) == sizeof(A*) + 2*sizeof(std::size_t));
+
+void test()
+{
+   A::count = 0;
+   {
+      bml::unique_ptr<A[], bml::sized_array_delete<A> > p(bml::make_unique_array<A>(3).release_unique_ptr());
+      BOOST_TEST(A::count == 3);
+      BOOST_TEST(p.get_deleter().size() == 3u);
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      bml::recycle_pool<A> pool;
+      {
+         bml::unique_ptr<A, bml::recycle_delete<A> > p(pool.acquire());
+         BOOST_TEST(A::count == 1);
+         BOOST_TEST(p.get_deleter().pool() == &pool);
+      }
+      //The stored pool got the object back
+      BOOST_TEST(A::count == 1);
+      BOOST_TEST(pool.free_count() == 1u);
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      bml::unique_ptr<A, bml::trailing_delete<A, int> > p(bml::make_unique_with_trailing<A, int>(4u));
+      BOOST_TEST(A::count == 1);
+      BOOST_TEST(p.get_deleter().size() == 4u);
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      bml::unique_ptr<A[], bml::aligned_delete<A> > p(bml::make_unique_aligned<A[]>(2u, 64u));
+      BOOST_TEST(A::count == 2);
+      BOOST_TEST(p.get_deleter().size() == 2u);
+      BOOST_TEST(p.get_deleter().alignment() == 64u);
+   }
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace unique_ptr_deleter_size_stateful{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   unique_ptr_deleter_size_stateless::test();
+   unique_ptr_deleter_size_stateful::test();
+
+   //Test results
+   return boost::report_errors();
+}
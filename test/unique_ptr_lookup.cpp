@@ -0,0 +1,177 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/unique_ptr.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <set>
+
+#if !defined(BOOST_NO_CXX11_HDR_UNORDERED_SET)
+#include <unordered_set>
+#endif
+
+namespace bml = ::boost::movelib;
+
+struct A
+{
+   static int count;
+   A() {++count;}
+   virtual ~A() {--count;}
+};
+
+int A::count = 0;
+
+struct B : A
+{};
+
+struct deleter
+{
+   void operator()(A *p) const
+   {  delete p;  }
+};
+
+////////////////////////////////
+//   unique_ptr_lookup_functors
+////////////////////////////////
+
+namespace unique_ptr_lookup_functors{
+
+void test()
+{
+   A::count = 0;
+   {
+      bml::unique_ptr<A> a(new A), b(new A);
+      bml::unique_ptr<A, deleter> c(new A);
+      const A *const pa = a.get();
+      B *const pb = 0;
+      bml::unique_ptr_less<A> less;
+      bml::unique_ptr_equal_to<A> eq;
+      bml::unique_ptr_hash<A> h;
+      //Any combination of owners and raw pointers
+      BOOST_TEST(less(a, b) == (a.get() < b.get()));
+      BOOST_TEST(less(a, b.get()) == (a.get() < b.get()));
+      BOOST_TEST(less(pa, b) == (a.get() < b.get()));
+      BOOST_TEST(less(a, c) == (a.get() < c.get()));
+      BOOST_TEST(!less(a, pa) && !less(pa, a));
+      BOOST_TEST(less(pb, a));
+      BOOST_TEST(eq(a, pa) && eq(pa, a));
+      BOOST_TEST(!eq(a, b) && !eq(c, a.get()));
+      BOOST_TEST(h(a) == h(pa));
+      BOOST_TEST(h(c) == h(c.get()));
+      #if !defined(BOOST_NO_CXX11_NULLPTR)
+      BOOST_TEST(less(nullptr, a) && !less(a, nullptr));
+      BOOST_TEST(eq(nullptr, bml::unique_ptr<A>()));
+      BOOST_TEST(h(nullptr) == h(bml::unique_ptr<A>()));
+      #endif
+      BOOST_TEST(eq(pb, bml::unique_ptr<A>()));
+   }
+   BOOST_TEST(A::count == 0);
+   {
+      //Arrays
+      bml::unique_ptr<A[]> a(new A[2]);
+      bml::unique_ptr_less<A[]> less;
+      bml::unique_ptr_equal_to<A[]> eq;
+      BOOST_TEST(eq(a, a.get()));
+      BOOST_TEST(!less(a, a.get()));
+   }
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace unique_ptr_lookup_functors{
+
+////////////////////////////////
+//   unique_ptr_lookup_search
+////////////////////////////////
+
+namespace unique_ptr_lookup_search{
+
+void test()
+{
+   A::count = 0;
+   {
+      //Sorted sequence searched with raw pointers
+      const std::size_t N = 8;
+      bml::unique_ptr<A> v[N];
+      A *raw[N];
+      for(std::size_t i = 0; i != N; ++i){
+         raw[i] = new A;
+      }
+      std::sort(raw, raw + N);
+      for(std::size_t i = 0; i != N; ++i){
+         v[i].reset(raw[i]);
+      }
+      for(std::size_t i = 0; i != N; ++i){
+         bml::unique_ptr<A> *const it = std::lower_bound(v, v + N, raw[i], bml::unique_ptr_less<A>());
+         BOOST_TEST(it == v + i);
+         BOOST_TEST(bml::unique_ptr_equal_to<A>()(*it, raw[i]));
+      }
+   }
+   BOOST_TEST(A::count == 0);
+   #if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+   {
+      //Null, raw and owner keys in the same set
+      typedef std::set<bml::unique_ptr<A>, bml::unique_ptr_less<A> > set_t;
+      set_t s;
+      A *const p = new A;
+      A *const q = new A;
+      BOOST_TEST(s.insert(bml::unique_ptr<A>()).second);
+      BOOST_TEST(s.insert(bml::unique_ptr<A>(p)).second);
+      BOOST_TEST(s.insert(bml::unique_ptr<A>(q)).second);
+      BOOST_TEST(!s.insert(bml::unique_ptr<A>()).second);
+      BOOST_TEST(s.size() == 3u);
+      bml::unique_ptr_less<A> less;
+      for(set_t::const_iterator it = s.begin(), nx = ++s.begin(); nx != s.end(); ++it, ++nx){
+         BOOST_TEST(less(*it, *nx) && !less(*nx, *it));
+         BOOST_TEST(less(it->get(), *nx) && less(*it, nx->get()));
+      }
+      #if defined(__cpp_lib_generic_associative_lookup)
+      BOOST_TEST(s.find(p) != s.end());
+      BOOST_TEST(s.find(p)->get() == p);
+      BOOST_TEST(s.count(static_cast<const A*>(q)) == 1u);
+      BOOST_TEST(s.count(static_cast<const A*>(0)) == 1u);
+      BOOST_TEST(s.find(nullptr) != s.end());
+      BOOST_TEST(!s.find(nullptr)->get());
+      bml::unique_ptr<A, deleter> other(new A);
+      BOOST_TEST(s.find(other) == s.end());
+      s.erase(s.find(q));
+      BOOST_TEST(s.count(q) == 0u && s.count(p) == 1u);
+      #endif
+   }
+   BOOST_TEST(A::count == 0);
+   #endif
+   #if defined(__cpp_lib_generic_unordered_lookup)
+   {
+      std::unordered_set<bml::unique_ptr<A>, bml::unique_ptr_hash<A>, bml::unique_ptr_equal_to<A> > s;
+      A *const p = new A;
+      s.insert(bml::unique_ptr<A>(p));
+      s.insert(bml::unique_ptr<A>(new A));
+      BOOST_TEST(s.find(p) != s.end());
+      BOOST_TEST(s.contains(p));
+      BOOST_TEST(!s.contains(nullptr));
+   }
+   BOOST_TEST(A::count == 0);
+   #endif
+}
+
+}  //namespace unique_ptr_lookup_search{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   unique_ptr_lookup_functors::test();
+   unique_ptr_lookup_search::test();
+
+   //Test results
+   return boost::report_errors();
+}
@@ -0,0 +1,341 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/utility_core.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/relative_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstring>
+#include <new>
+
+namespace bml = ::boost::movelib;
+namespace bmupmu = ::boost::move_upmu;
+namespace bmupd = ::boost::move_upd;
+
+//A memory segment that can be copied to a different address,
+//simulating a shared memory segment or a file mapped at a different base
+union segment
+{
+   double align;
+   char data[1024];
+};
+
+struct A
+{
+   static int count;
+   int v;
+   explicit A(int x = 0) : v(x) {  ++count;  }
+   virtual ~A() {  --count;  }
+};
+
+int A::count = 0;
+
+struct B : A
+{
+   explicit B(int x = 0) : A(x) {}
+};
+
+//Destroys objects placed in a segment without freeing the memory
+template<class T>
+struct seg_delete
+{
+   typedef bml::relative_ptr<T> pointer;
+
+   seg_delete() {}
+
+   template<class U>
+   seg_delete(const seg_delete<U> &) {}
+
+   void operator()(pointer p) const
+   {  p->~T();  }
+};
+
+template<class T>
+struct seg_delete<T[]>
+{
+   typedef bml::relative_ptr<T> pointer;
+
+   explicit seg_delete(std::size_t n = 0) : m_n(n) {}
+
+   void operator()(pointer p) const
+   {
+      for(std::size_t i = m_n; i; --i)
+         p[std::ptrdiff_t(i - 1)].~T();
+   }
+
+   std::size_t m_n;
+};
+
+////////////////////////////////
+//   relative_ptr_basic
+////////////////////////////////
+
+namespace relative_ptr_basic{
+
+void test()
+{
+   int a[4] = { 1, 2, 3, 4 };
+   bml::relative_ptr<int> p;
+   BOOST_TEST(!p);
+   BOOST_TEST(p.get() == 0);
+   p = a;
+   BOOST_TEST(!!p);
+   BOOST_TEST(p == a);
+   BOOST_TEST(*p == 1);
+   BOOST_TEST(p[2] == 3);
+   ++p;
+   BOOST_TEST(*p == 2);
+   bml::relative_ptr<int> q(p + 2);
+   BOOST_TEST(*q == 4);
+   BOOST_TEST(q - p == 2);
+   BOOST_TEST(p < q);
+   BOOST_TEST(q != p);
+   bml::relative_ptr<const int> c(q);
+   BOOST_TEST(c == q);
+   c = p;
+   BOOST_TEST(*c == 2);
+   swap(p, q);
+   BOOST_TEST(*p == 4 && *q == 2);
+   p = 0;
+   BOOST_TEST(!p);
+
+   //Not convertible from unrelated or less qualified types
+   BOOST_STATIC_ASSERT(( bmupmu::is_convertible<bml::relative_ptr<int>, bml::relative_ptr<const int> >::value ));
+   BOOST_STATIC_ASSERT(( !bmupmu::is_convertible<bml::relative_ptr<const int>, bml::relative_ptr<int> >::value ));
+   BOOST_STATIC_ASSERT(( bmupmu::is_convertible<bml::relative_ptr<B>, bml::relative_ptr<A> >::value ));
+   BOOST_STATIC_ASSERT(( !bmupmu::is_convertible<bml::relative_ptr<A>, bml::relative_ptr<B> >::value ));
+}
+
+}  //namespace relative_ptr_basic{
+
+////////////////////////////////
+//   relative_ptr_void
+////////////////////////////////
+
+namespace relative_ptr_void{
+
+void test()
+{
+   int i = 1;
+   bml::relative_ptr<int> pi(&i);
+   bml::relative_ptr<void> p;
+   BOOST_TEST(!p);
+   p = pi;
+   BOOST_TEST(!!p);
+   BOOST_TEST(p.get() == static_cast<void*>(&i));
+   BOOST_TEST(p == pi);
+   bml::relative_ptr<void> q(p);
+   BOOST_TEST(q == p);
+   bml::relative_ptr<const void> c(q);
+   BOOST_TEST(c.get() == static_cast<const void*>(&i));
+   swap(p, q);
+   BOOST_TEST(p == q);
+   p = 0;
+   BOOST_TEST(!p && p != q);
+
+   BOOST_STATIC_ASSERT(( bmupmu::is_convertible<bml::relative_ptr<int>, bml::relative_ptr<void> >::value ));
+   BOOST_STATIC_ASSERT(( bmupmu::is_convertible<bml::relative_ptr<void>, bml::relative_ptr<const void> >::value ));
+   BOOST_STATIC_ASSERT(( !bmupmu::is_convertible<bml::relative_ptr<void>, bml::relative_ptr<int> >::value ));
+}
+
+}  //namespace relative_ptr_void{
+
+////////////////////////////////
+//   unique_ptr_relative_traits
+////////////////////////////////
+
+namespace unique_ptr_relative_traits{
+
+void test()
+{
+   typedef bml::unique_ptr<A, seg_delete<A> > up_t;
+   BOOST_STATIC_ASSERT(( bmupmu::is_same<up_t::pointer, bml::relative_ptr<A> >::value ));
+   BOOST_STATIC_ASSERT(( bmupmu::is_same<bmupd::get_element_type<bml::relative_ptr<A> >::type, A>::value ));
+   BOOST_STATIC_ASSERT(( bmupmu::is_same<bmupd::get_element_type<bml::relative_ptr<const A> >::type, const A>::value ));
+   BOOST_STATIC_ASSERT(( bmupd::is_unique_ptr_convertible
+      <false, bml::relative_ptr<B>, bml::relative_ptr<A> >::value ));
+   BOOST_STATIC_ASSERT(( bmupd::is_unique_ptr_convertible
+      <false, B*, bml::relative_ptr<A> >::value ));
+   //Arrays only accept the same element type with more cv qualification
+   BOOST_STATIC_ASSERT(( bmupd::is_unique_ptr_convertible
+      <true, bml::relative_ptr<int>, bml::relative_ptr<const int> >::value ));
+   BOOST_STATIC_ASSERT(( !bmupd::is_unique_ptr_convertible
+      <true, bml::relative_ptr<B>, bml::relative_ptr<A> >::value ));
+   BOOST_STATIC_ASSERT(( !bmupd::is_unique_ptr_convertible
+      <true, B*, bml::relative_ptr<A> >::value ));
+}
+
+}  //namespace unique_ptr_relative_traits{
+
+////////////////////////////////
+//   unique_ptr_relative_nullptr
+////////////////////////////////
+
+namespace unique_ptr_relative_nullptr{
+
+void test()
+{
+   segment seg;
+   A::count = 0;
+   typedef bml::unique_ptr<A, seg_delete<A> > up_t;
+   {
+      up_t p(0);
+      BOOST_TEST(!p);
+      BOOST_TEST(!p.get());
+
+      p.reset(::new(seg.data) A(1));
+      BOOST_TEST(!!p);
+      BOOST_TEST(p->v == 1);
+      BOOST_TEST(A::count == 1);
+      p = 0;
+      BOOST_TEST(!p);
+      BOOST_TEST(A::count == 0);
+
+      p.reset(::new(seg.data) A(2));
+      p.reset(0);
+      BOOST_TEST(A::count == 0);
+
+      up_t q(0, seg_delete<A>());
+      BOOST_TEST(!q);
+      q.reset();
+      BOOST_TEST(!q);
+   }
+   #if !defined(BOOST_NO_CXX11_NULLPTR)
+   {
+      up_t p(nullptr);
+      BOOST_TEST(p == nullptr);
+      BOOST_TEST(nullptr == p);
+      BOOST_TEST(!(p != nullptr));
+      BOOST_TEST(!(p < nullptr));
+      BOOST_TEST(!(nullptr < p));
+      BOOST_TEST(!(p > nullptr));
+      BOOST_TEST(p <= nullptr);
+      BOOST_TEST(p >= nullptr);
+
+      p.reset(::new(seg.data) A(1));
+      BOOST_TEST(p != nullptr);
+      BOOST_TEST(nullptr != p);
+      p = nullptr;
+      BOOST_TEST(A::count == 0);
+      p.reset(::new(seg.data) A(2));
+      p.reset(nullptr);
+      BOOST_TEST(A::count == 0);
+      up_t q(nullptr, seg_delete<A>());
+      BOOST_TEST(!q);
+   }
+   #endif   //#if !defined(BOOST_NO_CXX11_NULLPTR)
+}
+
+}  //namespace unique_ptr_relative_nullptr{
+
+////////////////////////////////
+//   unique_ptr_relative_move
+////////////////////////////////
+
+namespace unique_ptr_relative_move{
+
+void test()
+{
+   segment seg;
+   A::count = 0;
+   {
+      bml::unique_ptr<B, seg_delete<B> > b(::new(seg.data) B(3));
+      bml::relative_ptr<B> const raw(b.get());
+      //Converting move construction and assignment
+      bml::unique_ptr<A, seg_delete<A> > a(boost::move(b));
+      BOOST_TEST(!b);
+      BOOST_TEST(a.get() == raw);
+      BOOST_TEST(a->v == 3);
+      b.reset(::new(seg.data + 64) B(4));
+      a = boost::move(b);
+      BOOST_TEST(A::count == 1);
+      BOOST_TEST(a->v == 4);
+
+      bml::unique_ptr<A, seg_delete<A> > c;
+      swap(a, c);
+      BOOST_TEST(!a);
+      BOOST_TEST(c->v == 4);
+
+      bml::relative_ptr<A> r(c.release());
+      BOOST_TEST(!c);
+      BOOST_TEST(r->v == 4);
+      seg_delete<A>()(r);
+      BOOST_TEST(A::count == 0);
+   }
+   {
+      //Arrays
+      int *const p = ::new(seg.data) int[3];
+      p[0] = 1; p[1] = 2; p[2] = 3;
+      bml::unique_ptr<int[], seg_delete<int[]> > a(p, seg_delete<int[]>(3));
+      BOOST_TEST(a[1] == 2);
+      a.reset(bml::relative_ptr<int>(p + 1));
+      BOOST_TEST(a[1] == 3);
+      a.reset(0);
+      BOOST_TEST(!a);
+   }
+}
+
+}  //namespace unique_ptr_relative_move{
+
+////////////////////////////////
+//   unique_ptr_relative_remap
+////////////////////////////////
+
+namespace unique_ptr_relative_remap{
+
+struct root
+{
+   bml::unique_ptr<A, seg_delete<A> > first;
+   bml::unique_ptr<A, seg_delete<A> > second;
+};
+
+void test()
+{
+   segment seg, remapped;
+   A::count = 0;
+   root *const r = ::new(seg.data) root;
+   r->first.reset(::new(seg.data + 64) A(5));
+   r->second.reset(::new(seg.data + 128) B(6));
+
+   //The whole segment is mapped at another address: owners are valid without fix-ups
+   std::memcpy(remapped.data, seg.data, sizeof(seg.data));
+   root *const r2 = reinterpret_cast<root*>(remapped.data);
+   BOOST_TEST(reinterpret_cast<char*>(r2->first.get().get()) == remapped.data + 64);
+   BOOST_TEST(r2->first->v == 5);
+   BOOST_TEST(r2->second->v == 6);
+
+   //Owners moved inside the remapped segment
+   r2->first = boost::move(r2->second);
+   BOOST_TEST(A::count == 1);
+   BOOST_TEST(r2->first->v == 6);
+   BOOST_TEST(!r2->second);
+   r2->~root();
+   BOOST_TEST(A::count == 0);
+}
+
+}  //namespace unique_ptr_relative_remap{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   relative_ptr_basic::test();
+   relative_ptr_void::test();
+   unique_ptr_relative_traits::test();
+   unique_ptr_relative_nullptr::test();
+   unique_ptr_relative_move::test();
+   unique_ptr_relative_remap::test();
+
+   //Test results
+   return boost::report_errors();
+}
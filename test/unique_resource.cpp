@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/unique_resource.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <fcntl.h>
+#endif
+
+namespace bml = ::boost::movelib;
+
+//Handles are indexes in a table of open flags
+bool g_open[16];
+int g_released = 0;
+
+int open_handle(int h)
+{  g_open[h] = true; return h;  }
+
+struct handle_close
+{
+   void operator()(int h) const
+   {  BOOST_TEST(g_open[h]); g_open[h] = false; ++g_released;  }
+};
+
+void fn_close(int h)
+{  handle_close()(h);  }
+
+typedef bml::unique_resource<int, handle_close, bml::invalid_value_sentinel<int, -1> > handle_t;
+typedef bml::unique_resource<int, void(*)(int), bml::invalid_value_sentinel<int, -1> > fn_handle_t;
+
+////////////////////////////////
+//   unique_resource_basic
+////////////////////////////////
+
+namespace unique_resource_basic{
+
+void test()
+{
+   //Only the handle is stored
+   BOOST_STATIC_ASSERT(sizeof(handle_t) == sizeof(int));
+   BOOST_STATIC_ASSERT(( ::boost::has_trivial_destructor_after_move<handle_t>::value ));
+   BOOST_STATIC_ASSERT(( ::boost::has_trivial_destructor_after_move<fn_handle_t>::value ));
+   g_released = 0;
+   {
+      handle_t h;
+      BOOST_TEST(!h);
+      BOOST_TEST(!h.valid());
+      BOOST_TEST(h.get() == -1);
+      //Zero is a valid handle
+      h.reset(open_handle(0));
+      BOOST_TEST(!!h);
+      BOOST_TEST(h.get() == 0);
+      h.reset(open_handle(1));
+      BOOST_TEST(!g_open[0] && g_open[1]);
+      BOOST_TEST(g_released == 1);
+
+      const int r = h.release();
+      BOOST_TEST(r == 1);
+      BOOST_TEST(!h);
+      BOOST_TEST(g_open[1]);
+      h.reset(r);
+
+      handle_t h2(open_handle(2));
+      swap(h, h2);
+      BOOST_TEST(h.get() == 2 && h2.get() == 1);
+   }
+   BOOST_TEST(!g_open[1] && !g_open[2]);
+   BOOST_TEST(g_released == 3);
+   {
+      //Function pointer deleters
+      fn_handle_t h(open_handle(3), &fn_close);
+      BOOST_TEST(h.get_deleter() == &fn_close);
+      fn_handle_t h2(boost::move(h));
+      BOOST_TEST(!h);
+      BOOST_TEST(h2.get() == 3);
+   }
+   BOOST_TEST(!g_open[3]);
+   BOOST_TEST(g_released == 4);
+
+   //Value initialized sentinel
+   bml::unique_resource<int, handle_close> z;
+   BOOST_TEST(z.get() == 0 && !z);
+}
+
+}  //namespace unique_resource_basic{
+
+////////////////////////////////
+//   unique_resource_move
+////////////////////////////////
+
+namespace unique_resource_move{
+
+handle_t make(int h)
+{  return handle_t(open_handle(h));  }
+
+void test()
+{
+   g_released = 0;
+   {
+      handle_t a(make(4));
+      handle_t b(boost::move(a));
+      BOOST_TEST(!a && b.get() == 4);
+      a = make(5);
+      a = boost::move(b);
+      BOOST_TEST(a.get() == 4);
+      BOOST_TEST(!b);
+      BOOST_TEST(!g_open[5] && g_open[4]);
+      BOOST_TEST(g_released == 1);
+   }
+   BOOST_TEST(g_released == 2);
+}
+
+}  //namespace unique_resource_move{
+
+////////////////////////////////
+//   unique_resource_close_all
+////////////////////////////////
+
+namespace unique_resource_close_all{
+
+void test()
+{
+   g_released = 0;
+   handle_t v[5];
+   for(int i = 6; i != 10; ++i){
+      v[i - 6].reset(open_handle(i));
+   }
+   bml::close_all(v, v + 5);
+   BOOST_TEST(g_released == 4);
+   for(std::size_t i = 0; i != 5; ++i){
+      BOOST_TEST(!v[i]);
+   }
+   for(int i = 6; i != 10; ++i){
+      BOOST_TEST(!g_open[i]);
+   }
+
+   #if defined(BOOST_HAS_UNISTD_H)
+   BOOST_STATIC_ASSERT(sizeof(bml::unique_fd) == sizeof(int));
+   {
+      //Descriptors, some of them consecutive
+      const std::size_t N = 6;
+      bml::unique_fd fds[N*2];
+      for(std::size_t i = 0; i != N; ++i){
+         int p[2];
+         BOOST_TEST(0 == ::pipe(p));
+         fds[i*2].reset(p[0]);
+         fds[i*2 + 1].reset(p[1]);
+      }
+      //Leave a gap, which must not be closed
+      bml::unique_fd keep(fds[3].release());
+      int raw[N*2];
+      for(std::size_t i = 0; i != N*2; ++i){
+         raw[i] = fds[i].get();
+      }
+      bml::close_all(fds, fds + N*2);
+      for(std::size_t i = 0; i != N*2; ++i){
+         BOOST_TEST(!fds[i]);
+         if(i != 3){
+            BOOST_TEST(::fcntl(raw[i], F_GETFD) == -1);
+         }
+      }
+      BOOST_TEST(::fcntl(keep.get(), F_GETFD) != -1);
+      const int k = keep.get();
+      keep.reset();
+      BOOST_TEST(::fcntl(k, F_GETFD) == -1);
+   }
+   #endif
+}
+
+}  //namespace unique_resource_close_all{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   unique_resource_basic::test();
+   unique_resource_move::test();
+   unique_resource_close_all::test();
+
+   //Test results
+   return boost::report_errors();
+}
@@ -0,0 +1,372 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/value_ptr.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <memory>
+
+namespace bml = ::boost::movelib;
+
+class Base
+{
+   public:
+   static int count;
+   static int clones;
+   int v;
+   explicit Base(int x = 0) : v(x) {++count;}
+   Base(const Base &x) : v(x.v) {++count;}
+   virtual ~Base() {--count;}
+   virtual Base *clone() const {  ++clones; return new Base(*this);  }
+   virtual int value() const {  return v;  }
+};
+
+int Base::count = 0;
+int Base::clones = 0;
+
+class Derived : public Base
+{
+   public:
+   int w;
+   Derived(int x, int y) : Base(x), w(y) {}
+   virtual Derived *clone() const {  ++clones; return new Derived(*this);  }
+   virtual int value() const {  return v + w;  }
+};
+
+class Abstract
+{
+   public:
+   virtual ~Abstract() {}
+   virtual Abstract *clone() const = 0;
+   virtual int value() const = 0;
+};
+
+class Concrete : public Abstract
+{
+   public:
+   int v;
+   explicit Concrete(int x) : v(x) {}
+   virtual Concrete *clone() const {  ++Base::clones; return new Concrete(*this);  }
+   virtual int value() const {  return v;  }
+};
+
+struct Plain
+{
+   int a, b;
+   Plain(int x, int y) : a(x), b(y) {}
+};
+
+void reset_counters()
+{  Base::count = 0; Base::clones = 0;  }
+
+////////////////////////////////
+//   value_ptr_copy
+////////////////////////////////
+
+namespace value_ptr_copy{
+
+void test()
+{
+   reset_counters();
+   {
+      typedef bml::value_ptr<Base> vp_t;
+      //Stateless cloner and deleter take no space
+      BOOST_TEST(sizeof(vp_t) == sizeof(Base*));
+
+      vp_t a(new Base(1));
+      vp_t b(a);
+      BOOST_TEST(a.get() != b.get());
+      BOOST_TEST(b->value() == 1);
+      BOOST_TEST(Base::count == 2);
+      //Same dynamic and static type: no virtual clone() call
+      BOOST_TEST(Base::clones == 0);
+
+      vp_t c(new Derived(1, 2));
+      vp_t d(c);
+      BOOST_TEST(d->value() == 3);
+      BOOST_TEST(dynamic_cast<Derived*>(d.get()) != 0);
+      BOOST_TEST(Base::clones == 1);
+      BOOST_TEST(Base::count == 4);
+
+      //Copy assignment
+      a = d;
+      BOOST_TEST(a->value() == 3);
+      BOOST_TEST(Base::clones == 2);
+      BOOST_TEST(Base::count == 4);
+
+      //Empty copies
+      vp_t e;
+      BOOST_TEST(!e);
+      vp_t f(e);
+      BOOST_TEST(!f);
+      a = e;
+      BOOST_TEST(!a);
+      BOOST_TEST(Base::count == 3);
+   }
+   BOOST_TEST(Base::count == 0);
+   reset_counters();
+   {
+      //Abstract types always call clone()
+      bml::value_ptr<Abstract> a(new Concrete(5));
+      bml::value_ptr<Abstract> b(a);
+      BOOST_TEST(b->value() == 5);
+      BOOST_TEST(a.get() != b.get());
+      BOOST_TEST(Base::clones == 1);
+   }
+   {
+      //Non-polymorphic types are copy constructed
+      bml::value_ptr<Plain> a(bml::make_value_ptr<Plain>(1, 2));
+      bml::value_ptr<Plain> b(a);
+      BOOST_TEST(b->a == 1 && b->b == 2);
+      BOOST_TEST(a.get() != b.get());
+   }
+}
+
+}  //namespace value_ptr_copy{
+
+////////////////////////////////
+//   value_ptr_move
+////////////////////////////////
+
+namespace value_ptr_move{
+
+bml::value_ptr<Base> make(int x)
+{  return bml::value_ptr<Base>(new Base(x));  }
+
+void test()
+{
+   reset_counters();
+   {
+      bml::value_ptr<Base> a(make(3));
+      Base *const p = a.get();
+      bml::value_ptr<Base> b(boost::move(a));
+      BOOST_TEST(!a);
+      BOOST_TEST(b.get() == p);
+      a = boost::move(b);
+      BOOST_TEST(a.get() == p);
+      BOOST_TEST(!b);
+      BOOST_TEST(Base::count == 1);
+      BOOST_TEST(Base::clones == 0);
+
+      b = make(4);
+      swap(a, b);
+      BOOST_TEST(a->value() == 4);
+      BOOST_TEST(b.get() == p);
+      BOOST_TEST(Base::count == 2);
+
+      Base *const r = b.release();
+      BOOST_TEST(!b);
+      b.reset(r);
+      BOOST_TEST(b.get() == r);
+      b = bml::value_ptr<Base>();
+      BOOST_TEST(Base::count == 1);
+      a.reset();
+      BOOST_TEST(Base::count == 0);
+   }
+}
+
+}  //namespace value_ptr_move{
+
+////////////////////////////////
+//   value_ptr_allocator
+////////////////////////////////
+
+namespace value_ptr_allocator{
+
+template<class T>
+struct counting_allocator
+   : std::allocator<T>
+{
+   template<class U> struct rebind {  typedef counting_allocator<U> other;  };
+   static int allocated;
+
+   counting_allocator() {}
+   template<class U> counting_allocator(const counting_allocator<U> &) {}
+
+   T *allocate(std::size_t n)
+   {  allocated += int(n); return std::allocator<T>().allocate(n);  }
+
+   void deallocate(T *p, std::size_t n)
+   {  allocated -= int(n); std::allocator<T>().deallocate(p, n);  }
+};
+
+template<class T>
+int counting_allocator<T>::allocated = 0;
+
+void test()
+{
+   typedef counting_allocator<char> alloc_t;
+   {
+      bml::value_ptr<Plain, bml::allocator_clone<Plain, alloc_t>, bml::allocator_delete<Plain, alloc_t> >
+         a(bml::allocate_value_ptr(alloc_t(), Plain(1, 2)));
+      BOOST_TEST(counting_allocator<Plain>::allocated == 1);
+      BOOST_TEST(a->a == 1 && a->b == 2);
+      {
+         bml::value_ptr<Plain, bml::allocator_clone<Plain, alloc_t>, bml::allocator_delete<Plain, alloc_t> > b(a);
+         BOOST_TEST(counting_allocator<Plain>::allocated == 2);
+         BOOST_TEST(b->a == 1 && b->b == 2);
+      }
+      BOOST_TEST(counting_allocator<Plain>::allocated == 1);
+   }
+   BOOST_TEST(counting_allocator<Plain>::allocated == 0);
+   //std::allocator has no rebind member since C++20
+   {
+      typedef std::allocator<char> std_alloc_t;
+      bml::value_ptr<Plain, bml::allocator_clone<Plain, std_alloc_t>, bml::allocator_delete<Plain, std_alloc_t> >
+         a(bml::allocate_value_ptr(std_alloc_t(), Plain(3, 4)));
+      bml::value_ptr<Plain, bml::allocator_clone<Plain, std_alloc_t>, bml::allocator_delete<Plain, std_alloc_t> > b(a);
+      BOOST_TEST(b->a == 3 && b->b == 4);
+      BOOST_TEST(a.get() != b.get());
+   }
+   {
+      bml::value_ptr<int, bml::allocator_clone<int, std::allocator<int> >, bml::allocator_delete<int, std::allocator<int> > >
+         a(bml::allocate_value_ptr<int>(std::allocator<int>(), 5));
+      BOOST_TEST(*a == 5);
+   }
+}
+
+}  //namespace value_ptr_allocator{
+
+////////////////////////////////
+//   inplace_value_ptr_copy
+////////////////////////////////
+
+namespace inplace_value_ptr_copy{
+
+class Big : public Base
+{
+   public:
+   char data[256];
+   explicit Big(int x) : Base(x) {  data[0] = 1;  }
+   virtual int value() const {  return v + data[0];  }
+};
+
+void test()
+{
+   reset_counters();
+   {
+      typedef bml::inplace_value_ptr<Base, 32> ivp_t;
+      ivp_t a;
+      BOOST_TEST(!a);
+      a.emplace<Derived>(1, 2);
+      BOOST_TEST(a.is_inline());
+      BOOST_TEST(a->value() == 3);
+
+      //Copies the dynamic type without calling clone()
+      ivp_t b(a);
+      BOOST_TEST(b.is_inline());
+      BOOST_TEST(b.get() != a.get());
+      BOOST_TEST(b->value() == 3);
+      BOOST_TEST(dynamic_cast<Derived*>(b.get()) != 0);
+      BOOST_TEST(Base::clones == 0);
+      BOOST_TEST(Base::count == 2);
+
+      //Objects that don't fit are stored in the heap
+      ivp_t c;
+      c.emplace<Big>(4);
+      BOOST_TEST(!c.is_inline());
+      ivp_t d(c);
+      BOOST_TEST(!d.is_inline());
+      BOOST_TEST(d->value() == 5);
+      BOOST_TEST(Base::count == 4);
+
+      a = c;
+      BOOST_TEST(!a.is_inline());
+      BOOST_TEST(a->value() == 5);
+      BOOST_TEST(Base::count == 4);
+
+      ivp_t e(boost::move(b));
+      BOOST_TEST(!b);
+      BOOST_TEST(e->value() == 3);
+      b = e;
+      BOOST_TEST(b->value() == 3);
+      swap(b, c);
+      BOOST_TEST(b->value() == 5);
+      BOOST_TEST(c->value() == 3);
+      BOOST_TEST(Base::count == 5);
+
+      //Copies of empty objects are empty
+      ivp_t f;
+      e = f;
+      BOOST_TEST(!e);
+      ivp_t g(f);
+      BOOST_TEST(!g);
+      BOOST_TEST(Base::count == 4);
+   }
+   BOOST_TEST(Base::count == 0);
+   BOOST_TEST(Base::clones == 0);
+}
+
+}  //namespace inplace_value_ptr_copy{
+
+////////////////////////////////
+//   value_ptr_throwing_cloner
+////////////////////////////////
+
+namespace value_ptr_throwing_cloner{
+
+struct throwing_clone
+   : bml::default_clone<Base>
+{
+   static bool throw_on_copy;
+
+   throwing_clone()
+   {}
+
+   throwing_clone(const throwing_clone &)
+      : bml::default_clone<Base>()
+   {  if(throw_on_copy) throw throw_on_copy;  }
+};
+
+bool throwing_clone::throw_on_copy = false;
+
+void test()
+{
+   #ifndef BOOST_NO_EXCEPTIONS
+   reset_counters();
+   {
+      typedef bml::value_ptr<Base, throwing_clone> vp_t;
+      BOOST_TEST(sizeof(vp_t) == sizeof(Base*));
+      vp_t a(new Base(1));
+      BOOST_TEST(Base::count == 1);
+      //The clone is owned before the cloner is copied, so it's not leaked
+      throwing_clone::throw_on_copy = true;
+      bool thrown = false;
+      try{
+         vp_t b(a);
+      }
+      catch(bool){
+         thrown = true;
+      }
+      throwing_clone::throw_on_copy = false;
+      BOOST_TEST(thrown);
+      BOOST_TEST(Base::count == 1);
+      BOOST_TEST(a->value() == 1);
+   }
+   BOOST_TEST(Base::count == 0);
+   #endif   //#ifndef BOOST_NO_EXCEPTIONS
+}
+
+}  //namespace value_ptr_throwing_cloner{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   value_ptr_copy::test();
+   value_ptr_move::test();
+   value_ptr_allocator::test();
+   inplace_value_ptr_copy::test();
+   value_ptr_throwing_cloner::test();
+
+   //Test results
+   return boost::report_errors();
+}
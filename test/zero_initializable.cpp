@@ -0,0 +1,267 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2014-2014.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/algorithm.hpp>
+#include <boost/move/traits.hpp>
+#include <boost/move/unique_ptr.hpp>
+#include <boost/move/unique_array.hpp>
+#include <boost/move/cow_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstring>   //memset
+
+namespace bml = ::boost::movelib;
+
+//A movable class whose zero bytes are its value-initialized state
+class handle
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(handle)
+   BOOST_MOVE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(handle)
+   BOOST_MOVE_ZERO_INITIALIZABLE(handle)
+
+   public:
+   static int constructions;
+   static int destructions;
+
+   handle() : m_id(0) { ++constructions; }
+   explicit handle(int id) : m_id(id) { ++constructions; }
+   handle(BOOST_RV_REF(handle) x) : m_id(x.m_id) { x.m_id = 0; ++constructions; }
+   handle& operator=(BOOST_RV_REF(handle) x) { m_id = x.m_id; x.m_id = 0; return *this; }
+   ~handle() { ++destructions; }
+
+   int m_id;
+};
+
+int handle::constructions = 0;
+int handle::destructions = 0;
+
+//The same class without markers
+class counted
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(counted)
+
+   public:
+   static int constructions;
+   static int assignments;
+
+   counted() : m_id(0) { ++constructions; }
+   explicit counted(int id) : m_id(id) { ++constructions; }
+   counted(BOOST_RV_REF(counted) x) : m_id(x.m_id) { x.m_id = 0; ++constructions; }
+   counted& operator=(BOOST_RV_REF(counted) x) { m_id = x.m_id; x.m_id = -1; ++assignments; return *this; }
+   ~counted() {}
+
+   int m_id;
+};
+
+int counted::constructions = 0;
+int counted::assignments = 0;
+
+//The marker is not inherited
+class derived_handle : public handle
+{};
+
+struct empty
+{};
+
+struct pointer_to_member
+{  int i;  };
+
+////////////////////////////////
+//   zero_initializable_trait
+////////////////////////////////
+
+namespace zero_initializable_trait{
+
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<int>::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<const double>::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<int*>::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<void(*)(int)>::value ));
+BOOST_STATIC_ASSERT(( !boost::is_zero_initializable<int pointer_to_member::*>::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<empty>::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<handle>::value ));
+BOOST_STATIC_ASSERT(( !boost::is_zero_initializable<derived_handle>::value ));
+BOOST_STATIC_ASSERT(( !boost::is_zero_initializable<counted>::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<bml::default_delete<int> >::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<bml::unique_ptr<int> >::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<bml::unique_ptr<int[]> >::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<bml::unique_ptr<int, void(*)(int*)> >::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<bml::unique_ptr<int, empty> >::value ));
+BOOST_STATIC_ASSERT(( !boost::is_zero_initializable<bml::unique_ptr<int, counted> >::value ));
+BOOST_STATIC_ASSERT(( !boost::is_zero_initializable<bml::unique_ptr<int, empty&> >::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<bml::unique_array<int> >::value ));
+BOOST_STATIC_ASSERT(( boost::is_zero_initializable<bml::cow_ptr<int> >::value ));
+
+void test()
+{}
+
+}  //namespace zero_initializable_trait{
+
+////////////////////////////////
+//   value_construct_n
+////////////////////////////////
+
+namespace value_construct_n{
+
+void test()
+{
+   //Zero-initializable types are cleared, constructors are not called
+   {
+      union { char raw[sizeof(handle)*4]; double align; } storage;
+      std::memset(storage.raw, 0xFF, sizeof(storage.raw));
+      handle *const p = reinterpret_cast<handle*>(storage.raw);
+      handle::constructions = 0;
+      handle *const e = boost::uninitialized_value_construct_n(p, 4u);
+      BOOST_TEST(e == p + 4);
+      BOOST_TEST(handle::constructions == 0);
+      for(int i = 0; i != 4; ++i){
+         BOOST_TEST(p[i].m_id == 0);
+      }
+   }
+   {
+      bml::unique_ptr<int> storage[3] = { bml::unique_ptr<int>(), bml::unique_ptr<int>(), bml::unique_ptr<int>() };
+      std::memset(static_cast<void*>(storage), 0xFF, sizeof(storage));
+      BOOST_TEST(boost::uninitialized_value_construct_n(storage, 3) == storage + 3);
+      for(int i = 0; i != 3; ++i){
+         BOOST_TEST(!storage[i]);
+      }
+   }
+   //Other types are value-initialized calling the constructor
+   {
+      union { char raw[sizeof(counted)*4]; double align; } storage;
+      std::memset(storage.raw, 0xFF, sizeof(storage.raw));
+      counted *const p = reinterpret_cast<counted*>(storage.raw);
+      counted::constructions = 0;
+      BOOST_TEST(boost::uninitialized_value_construct_n(p, 4) == p + 4);
+      BOOST_TEST(counted::constructions == 4);
+      for(int i = 0; i != 4; ++i){
+         BOOST_TEST(p[i].m_id == 0);
+         p[i].~counted();
+      }
+   }
+   //Zero elements
+   {
+      int i = 1;
+      BOOST_TEST(boost::uninitialized_value_construct_n(&i, 0) == &i);
+      BOOST_TEST(i == 1);
+   }
+}
+
+}  //namespace value_construct_n{
+
+////////////////////////////////
+//   reset_moved_from
+////////////////////////////////
+
+namespace reset_moved_from{
+
+void test()
+{
+   //Moved-from unique_ptrs are reset with memset
+   {
+      bml::unique_ptr<int> src[3];
+      bml::unique_ptr<int> dst[3];
+      for(int i = 0; i != 3; ++i){
+         src[i].reset(new int(i));
+         dst[i] = boost::move(src[i]);
+      }
+      boost::reset_moved_from_range(src, src + 3);
+      for(int i = 0; i != 3; ++i){
+         BOOST_TEST(!src[i]);
+         BOOST_TEST(*dst[i] == i);
+      }
+   }
+   //Marked types are cleared without calling destructors
+   {
+      handle src[2] = { handle(1), handle(2) };
+      handle dst[2];
+      dst[0] = boost::move(src[0]);
+      dst[1] = boost::move(src[1]);
+      src[0].m_id = src[1].m_id = 7;
+      handle::destructions = 0;
+      boost::reset_moved_from_range(src, src + 2);
+      BOOST_TEST(handle::destructions == 0);
+      BOOST_TEST(src[0].m_id == 0 && src[1].m_id == 0);
+   }
+   //Other types are assigned a value-initialized object
+   {
+      counted src[2];
+      counted::assignments = 0;
+      boost::reset_moved_from_range(src, src + 2);
+      BOOST_TEST(counted::assignments == 2);
+      BOOST_TEST(src[0].m_id == 0 && src[1].m_id == 0);
+   }
+}
+
+}  //namespace reset_moved_from{
+
+////////////////////////////////
+//   calloc_unique_array
+////////////////////////////////
+
+namespace calloc_unique_array{
+
+void test()
+{
+   //Big arrays of zero-initializable elements are allocated with calloc
+   const std::size_t big = BOOST_MOVE_CALLOC_THRESHOLD;
+   {
+      bml::unique_array<bml::unique_ptr<int> > a(bml::make_unique_array<bml::unique_ptr<int> >(big));
+      BOOST_TEST(a.size() == big);
+      for(std::size_t i = 0; i != a.size(); ++i){
+         BOOST_TEST(!a[i]);
+      }
+      a[10].reset(new int(10));
+      BOOST_TEST(*a[10] == 10);
+   }
+   {
+      handle::constructions = handle::destructions = 0;
+      {
+         bml::unique_array<handle> a(bml::make_unique_array<handle>(big));
+         BOOST_TEST(handle::constructions == 0);
+         BOOST_TEST(a[big-1].m_id == 0);
+      }
+      BOOST_TEST(handle::destructions == int(big));
+   }
+   //Small arrays still call constructors
+   {
+      handle::constructions = 0;
+      bml::unique_array<handle> a(bml::make_unique_array<handle>(8));
+      BOOST_TEST(handle::constructions == 8);
+   }
+   {
+      bml::unique_array<int> a(bml::make_unique_array_definit<int>(big));
+      a[big-1] = 3;
+      bml::unique_array<int> b(bml::make_unique_array<int>(0));
+      BOOST_TEST(b.size() == 0u);
+   }
+   //Other types always call constructors
+   {
+      counted::constructions = 0;
+      bml::unique_array<counted> a(bml::make_unique_array<counted>(5));
+      BOOST_TEST(counted::constructions == 5);
+   }
+}
+
+}  //namespace calloc_unique_array{
+
+////////////////////////////////
+//             main
+////////////////////////////////
+int main()
+{
+   zero_initializable_trait::test();
+   value_construct_n::test();
+   reset_moved_from::test();
+   calloc_unique_array::test();
+
+   //Test results
+   return boost::report_errors();
+}